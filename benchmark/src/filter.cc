@@ -7,6 +7,7 @@
 
 #include <iostream>
 
+#include <libtensor/active.hh>
 #include <libtensor/filter.hh>
 #include <libtensor/libtensor.hh>
 
@@ -35,4 +36,22 @@ static void BM_conv2d(benchmark::State &state) {
 }
 BENCHMARK(BM_conv2d)->Iterations(1000);
 
+static void BM_conv2d_active(benchmark::State &state) {
+  const auto filter = get_filter();
+  const auto size = static_cast<std::size_t>(1024);
+  const auto shape = Tensor2D::Shape({size, size});
+  // Planar interface across the middle of the domain
+  auto tensor = Tensor2D::fromShape(shape).fill(0.0);
+  for (std::size_t i = 0; i < size / 2; ++i) {
+    tensor[i].fill(1.0);
+  }
+  auto ret = Tensor2D::like(tensor);
+  libtensor::ActiveMask<2> mask(shape, 32);
+  mask.rebuild(tensor);
+  for (auto _ : state) {
+    libtensor::conv2d_active<double>(mask, tensor, filter, ret);
+  }
+}
+BENCHMARK(BM_conv2d_active)->Iterations(1000);
+
 BENCHMARK_MAIN();
@@ -4,6 +4,7 @@
  */
 
 #include <benchmark/benchmark.h>
+#include <cmath>
 #include <iostream>
 #include <libtensor/libtensor.hh>
 
@@ -43,4 +44,71 @@ static void BM_map2D(benchmark::State &state) {
 }
 BENCHMARK(BM_map2D)->Iterations(1000);
 
+static void BM_map_exp(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(256);
+  const auto t = Tensor2D::fromShape({size, size}).fill(0.5);
+  auto ret = Tensor2D::like(t);
+  for (auto _ : state) {
+    ret.map(libtensor::functor::ExpFunctor<double>(), t);
+    benchmark::DoNotOptimize(ret[0][0]);
+  }
+}
+BENCHMARK(BM_map_exp);
+
+static void BM_map_std_exp(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(256);
+  const auto t = Tensor2D::fromShape({size, size}).fill(0.5);
+  auto ret = Tensor2D::like(t);
+  for (auto _ : state) {
+    ret.map([](double &r, const double &x) { r = std::exp(x); }, t);
+    benchmark::DoNotOptimize(ret[0][0]);
+  }
+}
+BENCHMARK(BM_map_std_exp);
+
+static void BM_map_tanh(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(256);
+  const auto t = Tensor2D::fromShape({size, size}).fill(0.5);
+  auto ret = Tensor2D::like(t);
+  for (auto _ : state) {
+    ret.map(libtensor::functor::TanhFunctor<double>(), t);
+    benchmark::DoNotOptimize(ret[0][0]);
+  }
+}
+BENCHMARK(BM_map_tanh);
+
+static void BM_map_std_tanh(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(256);
+  const auto t = Tensor2D::fromShape({size, size}).fill(0.5);
+  auto ret = Tensor2D::like(t);
+  for (auto _ : state) {
+    ret.map([](double &r, const double &x) { r = std::tanh(x); }, t);
+    benchmark::DoNotOptimize(ret[0][0]);
+  }
+}
+BENCHMARK(BM_map_std_tanh);
+
+static void BM_add_alloc(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(256);
+  const auto t1 = Tensor2D::fromShape({size, size}).fill(1.0);
+  const auto t2 = Tensor2D::like(t1).fill(2.0);
+  for (auto _ : state) {
+    const auto ret = t1 + t2;
+    benchmark::DoNotOptimize(ret[0][0]);
+  }
+}
+BENCHMARK(BM_add_alloc);
+
+static void BM_add_out(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(256);
+  const auto t1 = Tensor2D::fromShape({size, size}).fill(1.0);
+  const auto t2 = Tensor2D::like(t1).fill(2.0);
+  Tensor2D ret;
+  for (auto _ : state) {
+    libtensor::add(ret, t1, t2);
+    benchmark::DoNotOptimize(ret[0][0]);
+  }
+}
+BENCHMARK(BM_add_out);
+
 BENCHMARK_MAIN();
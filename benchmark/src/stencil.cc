@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <libtensor/filter.hh>
+#include <libtensor/libtensor.hh>
+#include <libtensor/stencil.hh>
+
+using Tensor2D = libtensor::Tensor<double, 2>;
+
+constexpr std::size_t size = 2048;
+constexpr std::size_t steps = 4;
+
+Tensor2D get_filter() {
+  auto t = Tensor2D::fromShape({3, 3});
+  t[0][0] = 0.0, t[0][1] = 1.0, t[0][2] = 0.0;
+  t[1][0] = 1.0, t[1][1] = -4.0, t[1][2] = 1.0;
+  t[2][0] = 0.0, t[2][1] = 1.0, t[2][2] = 0.0;
+  return t;
+}
+
+static void BM_conv2d_steps(benchmark::State &state) {
+  const auto filter = get_filter();
+  auto tensor = Tensor2D::fromShape({size, size}).fill(1.0);
+  auto lap = Tensor2D::like(tensor);
+  for (auto _ : state) {
+    for (std::size_t s = 0; s < steps; ++s) {
+      libtensor::conv2d<double>(tensor, filter, lap);
+      tensor.map([](double &u, const double &l) { u += 0.1 * l; }, lap);
+    }
+  }
+}
+BENCHMARK(BM_conv2d_steps)->Iterations(10);
+
+static void BM_stencil2d(benchmark::State &state) {
+  const auto filter = get_filter();
+  auto tensor = Tensor2D::fromShape({size, size}).fill(1.0);
+  auto ret = Tensor2D::like(tensor);
+  const auto f = [](double &ret, const double &u, const double &l) { ret = u + 0.1 * l; };
+  for (auto _ : state) {
+    libtensor::stencil2d<double>(tensor, filter, ret, f, steps, state.range(0));
+  }
+}
+BENCHMARK(BM_stencil2d)->Iterations(10)->Arg(32)->Arg(64)->Arg(128);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LIBTENSOR__IMPL__ACTIVE__
+#define __LIBTENSOR__IMPL__ACTIVE__
+
+#include "filter.hh"
+#include "libtensor.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace libtensor {
+/*
+ * Block-sparse activity mask for narrow-band computation.
+ *
+ * The grid is split into tiles of `tile` points per axis. Every tile is classified as saturated
+ * at `lo`, saturated at `hi` or mixed (interface). A tile is active when it is mixed or when one
+ * of its 3^N - 1 neighbouring tiles (faces, edges and corners) is in a different state, so that the
+ * band covers every cell a 3x3 (3x3x3) stencil, including its diagonal weights, can reach from the
+ * interface. Operations restricted to the mask never touch
+ * inactive tiles, hence `update` only has to rescan the tiles that were active before.
+ */
+template <std::size_t N>
+class ActiveMask {
+  static_assert(N == 2 || N == 3, "ActiveMask supports 2D and 3D grids");
+
+public:
+  using Shape = libtensor::Shape<N>;
+  using Flags = Tensor<std::uint8_t, N>;
+
+  enum State : std::uint8_t { LOWER = 0, UPPER = 1, MIXED = 2 };
+
+private:
+  Shape dims;
+  Shape n_tiles;
+  std::size_t tile_size;
+  Flags state;
+  Flags flags;
+  std::vector<Shape> active_tiles;
+
+public:
+  ActiveMask(const Shape &s, const std::size_t tile = 16) : dims(s), tile_size(tile) {
+    if (tile == 0) {
+      throw std::invalid_argument("invalid tile size");
+    }
+    for (std::size_t d = 0; d < N; ++d) {
+      this->n_tiles[d] = (s[d] + tile - 1) / tile;
+    }
+    this->state.resize(this->n_tiles).fill(MIXED);
+    this->flags.resize(this->n_tiles).fill(1);
+    this->collect();
+  }
+
+  inline const Shape &shape() const { return this->dims; }
+  inline const Shape &tiles() const { return this->n_tiles; }
+  inline std::size_t tile() const { return this->tile_size; }
+  inline const std::vector<Shape> &list() const { return this->active_tiles; }
+  inline std::size_t n_active() const { return this->active_tiles.size(); }
+
+  bool active(const Shape &c) const {
+    if constexpr (N == 2) {
+      return this->flags[c[0]][c[1]] != 0;
+    } else {
+      return this->flags[c[0]][c[1]][c[2]] != 0;
+    }
+  }
+
+  /* First and last + 1 grid index covered by tile `c` */
+  void bounds(const Shape &c, Shape &begin, Shape &end) const {
+    for (std::size_t d = 0; d < N; ++d) {
+      begin[d] = c[d] * this->tile_size;
+      end[d] = std::min(begin[d] + this->tile_size, this->dims[d]);
+    }
+  }
+
+  /* Mark every tile active, e.g. before the field has been initialised */
+  ActiveMask &set_all() {
+    this->state.fill(MIXED);
+    this->flags.fill(1);
+    this->collect();
+    return *this;
+  }
+
+  /* Classify every tile of `t` */
+  template <typename T>
+  ActiveMask &rebuild(const Tensor<T, N> &t, const T lo = T{0}, const T hi = T{1},
+                      const T tol = T{1e-6}) {
+    this->check(t);
+    const auto n = this->count();
+#pragma omp parallel for
+    for (std::size_t k = 0; k < n; ++k) {
+      const auto c = this->coord(k);
+      this->state_at(c) = this->classify(t, c, lo, hi, tol);
+    }
+    this->dilate();
+    return *this;
+  }
+
+  /* Reclassify only the tiles that were active, i.e. the only ones a masked step can modify */
+  template <typename T>
+  ActiveMask &update(const Tensor<T, N> &t, const T lo = T{0}, const T hi = T{1},
+                     const T tol = T{1e-6}) {
+    this->check(t);
+    const auto n = this->active_tiles.size();
+#pragma omp parallel for
+    for (std::size_t k = 0; k < n; ++k) {
+      const auto &c = this->active_tiles[k];
+      this->state_at(c) = this->classify(t, c, lo, hi, tol);
+    }
+    this->dilate();
+    return *this;
+  }
+
+private:
+  template <typename T>
+  void check(const Tensor<T, N> &t) const {
+    if (t.shape() != this->dims) {
+      throw std::invalid_argument("invalid dimensions");
+    }
+  }
+
+  std::size_t count() const {
+    std::size_t n = 1;
+    for (std::size_t d = 0; d < N; ++d) {
+      n *= this->n_tiles[d];
+    }
+    return n;
+  }
+
+  Shape coord(std::size_t k) const {
+    Shape c;
+    for (std::size_t d = N; d-- > 0;) {
+      c[d] = k % this->n_tiles[d];
+      k /= this->n_tiles[d];
+    }
+    return c;
+  }
+
+  std::uint8_t &state_at(const Shape &c) {
+    if constexpr (N == 2) {
+      return this->state[c[0]][c[1]];
+    } else {
+      return this->state[c[0]][c[1]][c[2]];
+    }
+  }
+
+  std::uint8_t state_at(const Shape &c) const {
+    if constexpr (N == 2) {
+      return this->state[c[0]][c[1]];
+    } else {
+      return this->state[c[0]][c[1]][c[2]];
+    }
+  }
+
+  template <typename T>
+  std::uint8_t classify(const Tensor<T, N> &t, const Shape &c, const T lo, const T hi,
+                        const T tol) const {
+    Shape b, e;
+    this->bounds(c, b, e);
+    bool at_lo = true, at_hi = true;
+    const auto visit = [&](const T v) {
+      at_lo = at_lo && (std::abs(v - lo) <= tol);
+      at_hi = at_hi && (std::abs(v - hi) <= tol);
+    };
+    for (std::size_t i = b[0]; i < e[0]; ++i) {
+      if constexpr (N == 2) {
+        const auto &row = t[i];
+        for (std::size_t j = b[1]; j < e[1]; ++j) {
+          visit(row[j]);
+        }
+      } else {
+        for (std::size_t j = b[1]; j < e[1]; ++j) {
+          const auto &row = t[i][j];
+          for (std::size_t l = b[2]; l < e[2]; ++l) {
+            visit(row[l]);
+          }
+        }
+      }
+      if (!at_lo && !at_hi) {
+        return MIXED;
+      }
+    }
+    return at_lo ? LOWER : UPPER;
+  }
+
+  /* A tile is active if it is mixed or differs from any tile of its 3^N neighbourhood */
+  void dilate() {
+    constexpr std::size_t n_offsets = (N == 2) ? 9 : 27;
+    const auto n = this->count();
+#pragma omp parallel for
+    for (std::size_t k = 0; k < n; ++k) {
+      const auto c = this->coord(k);
+      const auto s = this->state_at(c);
+      bool on = (s == MIXED);
+      for (std::size_t o = 0; o < n_offsets && !on; ++o) {
+        // Offset digit d of o (base 3) is the step along axis d
+        auto nc = c;
+        bool inside = true;
+        for (std::size_t d = 0, code = o; d < N; ++d, code /= 3) {
+          const int64_t x = static_cast<int64_t>(c[d]) + static_cast<int64_t>(code % 3) - 1;
+          inside = inside && x >= 0 && x < static_cast<int64_t>(this->n_tiles[d]);
+          nc[d] = static_cast<std::size_t>(x);
+        }
+        on = inside && (this->state_at(nc) != s);
+      }
+      if constexpr (N == 2) {
+        this->flags[c[0]][c[1]] = on;
+      } else {
+        this->flags[c[0]][c[1]][c[2]] = on;
+      }
+    }
+    this->collect();
+  }
+
+  void collect() {
+    this->active_tiles.clear();
+    const auto n = this->count();
+    for (std::size_t k = 0; k < n; ++k) {
+      const auto c = this->coord(k);
+      if (this->active(c)) {
+        this->active_tiles.push_back(c);
+      }
+    }
+  }
+};
+
+/* Apply a functor like Tensor::map, but only on the active tiles of `mask` */
+template <typename T, std::size_t N, typename F, typename... Tensors>
+Tensor<T, N> &map_active(const ActiveMask<N> &mask, Tensor<T, N> &tensor, F &&f,
+                         const Tensors &...others) {
+  static_assert((std::is_same_v<std::decay_t<Tensors>, Tensor<T, N>> && ...));
+  if (tensor.shape() != mask.shape() || ((others.shape() != mask.shape()) || ...)) {
+    throw std::invalid_argument("invalid dimensions");
+  }
+
+  const auto &tiles = mask.list();
+#pragma omp parallel for
+  for (std::size_t k = 0; k < tiles.size(); ++k) {
+    Shape<N> b, e;
+    mask.bounds(tiles[k], b, e);
+    for (std::size_t i = b[0]; i < e[0]; ++i) {
+      if constexpr (N == 2) {
+        auto &row = tensor[i];
+        for (std::size_t j = b[1]; j < e[1]; ++j) {
+          f(row[j], others[i][j]...);
+        }
+      } else {
+        for (std::size_t j = b[1]; j < e[1]; ++j) {
+          auto &row = tensor[i][j];
+          for (std::size_t l = b[2]; l < e[2]; ++l) {
+            f(row[l], others[i][j][l]...);
+          }
+        }
+      }
+    }
+  }
+  return tensor;
+}
+
+/*
+ * 3x3 convolution evaluated only on the active tiles of `mask`.
+ * Results match conv2d on those tiles; inactive tiles of `ret` are left untouched.
+ */
+template <typename T, BorderType BT = BorderType::REFLECT>
+void conv2d_active(const ActiveMask<2> &mask, const Tensor<T, 2> &tensor,
+                   const Tensor<T, 2> &filter, Tensor<T, 2> &ret,
+                   [[maybe_unused]] T cst = T{}) {
+  const auto &t_shape = tensor.shape();
+  if (filter.shape() != Shape<2>({3, 3})) {
+    throw std::invalid_argument("invalid shape of kernel given");
+  }
+  if (ret.shape() != t_shape || mask.shape() != t_shape) {
+    throw std::invalid_argument("shape result does not match between give & result");
+  }
+  const int64_t ny = t_shape[0];
+  const int64_t nx = t_shape[1];
+  T w[3][3];
+  for (std::size_t m = 0; m < 3; ++m) {
+    for (std::size_t n = 0; n < 3; ++n) {
+      w[m][n] = filter[m][n];
+    }
+  }
+
+  const auto &tiles = mask.list();
+#pragma omp parallel for
+  for (std::size_t k = 0; k < tiles.size(); ++k) {
+    Shape<2> b, e;
+    mask.bounds(tiles[k], b, e);
+    for (int64_t i = b[0]; i < static_cast<int64_t>(e[0]); ++i) {
+      auto &out = ret[i];
+      const bool y_edge = (i == 0 || i == ny - 1);
+      for (int64_t j = b[1]; j < static_cast<int64_t>(e[1]); ++j) {
+        const bool edge = y_edge || (j == 0 || j == nx - 1);
+        if constexpr (BT == BorderType::INTERNAL) {
+          if (edge) {
+            out[j] = T{0};
+            continue;
+          }
+        }
+        T acc = T{0};
+        for (int64_t m = 0; m < 3; ++m) {
+          const int64_t y = edge ? border_index<BT>(i + m - 1, ny) : i + m - 1;
+          for (int64_t n = 0; n < 3; ++n) {
+            const int64_t x = edge ? border_index<BT>(j + n - 1, nx) : j + n - 1;
+            acc += ((y < 0 || x < 0) ? cst : tensor[y][x]) * w[m][n];
+          }
+        }
+        out[j] = acc;
+      }
+    }
+  }
+}
+} // namespace libtensor
+#endif
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LIBTENSOR__IMPL__COMPRESS__
+#define __LIBTENSOR__IMPL__COMPRESS__
+
+#include "libtensor.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace libtensor {
+/*
+ * Lossless block compression of tensors.
+ *
+ * The flattened (row-major) tensor is split into blocks of `block` elements that are encoded
+ * independently and in parallel:
+ *   1. XOR predictor: every value is replaced by the XOR of its bit pattern with the previous one,
+ *      which clears the sign, exponent and leading mantissa bits of smooth fields.
+ *   2. Byte shuffle: byte k of every value is stored in plane k, grouping the zero bytes.
+ *   3. Run-length coding: the shuffled stream is stored as literal and zero runs.
+ *
+ * Stream layout (host byte order):
+ *   "LTZ1" | u32 n_dims | u32 sizeof(T) | u64 shape[n_dims] | u64 block | u64 n_blocks
+ *   | u64 offsets[n_blocks + 1] | payload
+ * The offset table allows single blocks or slabs to be decoded without reading the whole stream.
+ */
+namespace codec {
+inline constexpr char magic[4] = {'L', 'T', 'Z', '1'};
+inline constexpr std::size_t min_zero_run = 4;
+
+template <std::size_t S>
+struct Word;
+template <>
+struct Word<1> {
+  using type = std::uint8_t;
+};
+template <>
+struct Word<2> {
+  using type = std::uint16_t;
+};
+template <>
+struct Word<4> {
+  using type = std::uint32_t;
+};
+template <>
+struct Word<8> {
+  using type = std::uint64_t;
+};
+
+inline void put_varint(std::vector<std::uint8_t> &out, std::uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(v));
+}
+
+inline std::uint64_t get_varint(const std::uint8_t *&p, const std::uint8_t *end) {
+  std::uint64_t v = 0;
+  for (int shift = 0; p < end && shift < 64; shift += 7) {
+    const std::uint8_t b = *p++;
+    v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+    if ((b & 0x80) == 0) {
+      return v;
+    }
+  }
+  throw std::runtime_error("corrupted compressed block");
+}
+
+/* Run-length coding of zero bytes; token = (length << 1) | is_zero_run */
+inline void rle_encode(const std::vector<std::uint8_t> &in, std::vector<std::uint8_t> &out) {
+  std::size_t i = 0, literal = 0;
+  const auto flush = [&](const std::size_t end) {
+    if (literal < end) {
+      put_varint(out, (end - literal) << 1);
+      out.insert(out.end(), in.begin() + literal, in.begin() + end);
+    }
+  };
+  while (i < in.size()) {
+    if (in[i] != 0) {
+      ++i;
+      continue;
+    }
+    std::size_t j = i;
+    while (j < in.size() && in[j] == 0) {
+      ++j;
+    }
+    if (j - i >= min_zero_run) {
+      flush(i);
+      put_varint(out, ((j - i) << 1) | 1);
+      literal = j;
+    }
+    i = j;
+  }
+  flush(in.size());
+}
+
+inline void rle_decode(const std::uint8_t *p, const std::uint8_t *end, std::uint8_t *out,
+                       const std::size_t n) {
+  std::size_t o = 0;
+  while (p < end) {
+    const auto token = get_varint(p, end);
+    const std::size_t len = token >> 1;
+    if (o + len > n || ((token & 1) == 0 && static_cast<std::size_t>(end - p) < len)) {
+      throw std::runtime_error("corrupted compressed block");
+    }
+    if (token & 1) {
+      std::fill(out + o, out + o + len, 0);
+    } else {
+      std::copy(p, p + len, out + o);
+      p += len;
+    }
+    o += len;
+  }
+  if (o != n) {
+    throw std::runtime_error("corrupted compressed block");
+  }
+}
+
+template <typename T>
+void encode_block(const T *values, const std::size_t n, std::vector<std::uint8_t> &out) {
+  using W = typename Word<sizeof(T)>::type;
+  std::vector<std::uint8_t> planes(n * sizeof(T));
+  W prev = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    W w;
+    std::memcpy(&w, &values[i], sizeof(T));
+    const W x = w ^ prev;
+    prev = w;
+    for (std::size_t k = 0; k < sizeof(T); ++k) {
+      planes[k * n + i] = static_cast<std::uint8_t>(x >> (8 * k));
+    }
+  }
+  out.clear();
+  rle_encode(planes, out);
+}
+
+template <typename T>
+void decode_block(const std::uint8_t *p, const std::uint8_t *end, const std::size_t n, T *values) {
+  using W = typename Word<sizeof(T)>::type;
+  std::vector<std::uint8_t> planes(n * sizeof(T));
+  rle_decode(p, end, planes.data(), planes.size());
+  W prev = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    W x = 0;
+    for (std::size_t k = 0; k < sizeof(T); ++k) {
+      x |= static_cast<W>(planes[k * n + i]) << (8 * k);
+    }
+    prev ^= x;
+    std::memcpy(&values[i], &prev, sizeof(T));
+  }
+}
+
+template <typename U>
+void write_raw(std::ostream &os, const U &v) {
+  os.write(reinterpret_cast<const char *>(&v), sizeof(U));
+}
+
+template <typename U>
+U read_raw(std::istream &is) {
+  U v;
+  if (!is.read(reinterpret_cast<char *>(&v), sizeof(U))) {
+    throw std::runtime_error("unexpected end of compressed stream");
+  }
+  return v;
+}
+} // namespace codec
+
+template <typename T, std::size_t N>
+void compress(std::ostream &os, const Tensor<T, N> &tensor,
+              const std::size_t block = std::size_t{1} << 16) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  if (block == 0) {
+    throw std::invalid_argument("invalid block size");
+  }
+  const std::size_t total = tensor.size();
+  const std::size_t n_blocks = (total + block - 1) / block;
+
+  std::vector<std::vector<std::uint8_t>> encoded(n_blocks);
+#pragma omp parallel
+  {
+    std::vector<T> values(std::min(block, total));
+#pragma omp for schedule(dynamic)
+    for (std::size_t b = 0; b < n_blocks; ++b) {
+      const std::size_t begin = b * block;
+      const std::size_t end = std::min(begin + block, total);
+      tensor.copy_to(begin, end, values.data());
+      codec::encode_block(values.data(), end - begin, encoded[b]);
+    }
+  }
+
+  os.write(codec::magic, sizeof(codec::magic));
+  codec::write_raw(os, static_cast<std::uint32_t>(N));
+  codec::write_raw(os, static_cast<std::uint32_t>(sizeof(T)));
+  for (const auto d : tensor.shape()) {
+    codec::write_raw(os, static_cast<std::uint64_t>(d));
+  }
+  codec::write_raw(os, static_cast<std::uint64_t>(block));
+  codec::write_raw(os, static_cast<std::uint64_t>(n_blocks));
+  std::uint64_t offset = 0;
+  codec::write_raw(os, offset);
+  for (const auto &e : encoded) {
+    offset += e.size();
+    codec::write_raw(os, offset);
+  }
+  for (const auto &e : encoded) {
+    os.write(reinterpret_cast<const char *>(e.data()), e.size());
+  }
+  if (!os) {
+    throw std::runtime_error("failed to write compressed stream");
+  }
+}
+
+/* Random-access reader of a stream written by compress */
+template <typename T, std::size_t N>
+class CompressedReader {
+public:
+  using Shape = libtensor::Shape<N>;
+
+private:
+  std::istream &is;
+  Shape dims;
+  std::size_t block;
+  std::vector<std::uint64_t> offsets;
+  std::streampos payload;
+
+public:
+  explicit CompressedReader(std::istream &s) : is(s) {
+    char m[sizeof(codec::magic)];
+    if (!this->is.read(m, sizeof(m)) || !std::equal(m, m + sizeof(m), codec::magic)) {
+      throw std::runtime_error("not a compressed tensor stream");
+    }
+    if (codec::read_raw<std::uint32_t>(this->is) != N ||
+        codec::read_raw<std::uint32_t>(this->is) != sizeof(T)) {
+      throw std::invalid_argument("tensor type does not match the compressed stream");
+    }
+    for (auto &d : this->dims) {
+      d = codec::read_raw<std::uint64_t>(this->is);
+    }
+    this->block = codec::read_raw<std::uint64_t>(this->is);
+    const std::size_t total = this->total();
+    if (this->block == 0 || (total > 0 && this->block > total)) {
+      throw std::runtime_error("corrupted compressed stream");
+    }
+    if (codec::read_raw<std::uint64_t>(this->is) != (total + this->block - 1) / this->block) {
+      throw std::runtime_error("corrupted compressed stream");
+    }
+    this->offsets.resize((total + this->block - 1) / this->block + 1);
+    for (auto &o : this->offsets) {
+      o = codec::read_raw<std::uint64_t>(this->is);
+    }
+    if (this->offsets[0] != 0 ||
+        !std::is_sorted(this->offsets.begin(), this->offsets.end())) {
+      throw std::runtime_error("corrupted compressed stream");
+    }
+    this->payload = this->is.tellg();
+  }
+
+  inline const Shape &shape() const { return this->dims; }
+  inline std::size_t block_size() const { return this->block; }
+  inline std::size_t n_blocks() const { return this->offsets.size() - 1; }
+
+  /* Decode the scalars with flat indices [begin, end) */
+  std::vector<T> read_range(const std::size_t begin, const std::size_t end) {
+    std::vector<T> ret(end > begin ? end - begin : 0);
+    this->decode(begin, end, [&](std::size_t lo, std::size_t hi, const T *v) {
+      std::copy(v, v + (hi - lo), ret.begin() + (lo - begin));
+    });
+    return ret;
+  }
+
+  Tensor<T, N> read() { return this->read_slab(0, this->dims[0]); }
+
+  /* Decode the sub-tensor [begin, end) along the first axis */
+  Tensor<T, N> read_slab(const std::size_t begin, const std::size_t end) {
+    if (begin > end || end > this->dims[0]) {
+      throw std::invalid_argument("invalid slab range");
+    }
+    auto s = this->dims;
+    s[0] = end - begin;
+    auto ret = Tensor<T, N>::fromShape(s);
+    const std::size_t stride = s[0] ? ret.size() / s[0] : 0;
+    this->decode(begin * stride, end * stride, [&](std::size_t lo, std::size_t hi, const T *v) {
+      ret.copy_from(lo - begin * stride, hi - begin * stride, v);
+    });
+    return ret;
+  }
+
+private:
+  std::size_t total() const {
+    std::size_t n = 1;
+    for (const auto d : this->dims) {
+      n *= d;
+    }
+    return n;
+  }
+
+  /* Read the covering blocks sequentially, then decode them in parallel */
+  template <typename F>
+  void decode(const std::size_t begin, const std::size_t end, F &&sink) {
+    if (begin > end || end > this->total()) {
+      throw std::invalid_argument("invalid range");
+    }
+    if (begin == end) {
+      return;
+    }
+    const std::size_t b0 = begin / this->block;
+    const std::size_t b1 = (end - 1) / this->block + 1;
+    std::vector<std::uint8_t> raw(this->offsets[b1] - this->offsets[b0]);
+    this->is.clear();
+    this->is.seekg(this->payload + static_cast<std::streamoff>(this->offsets[b0]));
+    if (!this->is.read(reinterpret_cast<char *>(raw.data()), raw.size())) {
+      throw std::runtime_error("unexpected end of compressed stream");
+    }
+
+    // An exception must not leave the parallel region, so the first one is rethrown after it
+    std::exception_ptr error;
+#pragma omp parallel
+    {
+      std::vector<T> values;
+#pragma omp for schedule(dynamic)
+      for (std::size_t b = b0; b < b1; ++b) {
+        try {
+          const std::size_t first = b * this->block;
+          const std::size_t n = std::min(first + this->block, this->total()) - first;
+          values.resize(n);
+          const auto *p = raw.data() + (this->offsets[b] - this->offsets[b0]);
+          const auto *e = raw.data() + (this->offsets[b + 1] - this->offsets[b0]);
+          codec::decode_block(p, e, n, values.data());
+          const std::size_t lo = std::max(begin, first);
+          const std::size_t hi = std::min(end, first + n);
+          sink(lo, hi, values.data() + (lo - first));
+        } catch (...) {
+#pragma omp critical
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+};
+
+template <typename T, std::size_t N>
+Tensor<T, N> decompress(std::istream &is) {
+  return CompressedReader<T, N>(is).read();
+}
+} // namespace libtensor
+#endif
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LIBTENSOR__CORE__FIELDSET__
+#define __LIBTENSOR__CORE__FIELDSET__
+
+#include "decl.hh"
+#include "shape.hh"
+#include "tensor.hh"
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace libtensor {
+/*
+ * Memory layout of the components of a FieldSet.
+ *   SOA: one Tensor per component (structure of arrays)
+ *   AOS: components of a grid point stored next to each other (array of structures)
+ */
+enum class Layout { SOA, AOS };
+
+template <typename T, std::size_t M, std::size_t N, Layout L = Layout::SOA>
+class FieldSet {
+  static_assert(M > 0, "FieldSet requires at least one component");
+
+public:
+  static const std::size_t n_fields = M;
+  static const std::size_t n_dims = N;
+  static constexpr Layout layout = L;
+  using scalar_type = T;
+  using point_type = std::array<T, M>;
+  using Shape = libtensor::Shape<N>;
+  using Field = Tensor<T, N>;
+  using Storage = typename std::conditional<(L == Layout::SOA), std::array<Field, M>,
+                                            Tensor<point_type, N>>::type;
+
+  static FieldSet fromShape(const Shape &s) { return FieldSet(s); }
+  static FieldSet like(const FieldSet &f) { return FieldSet(f.shape()); }
+
+private:
+  Shape dims = {0};
+  Storage storage;
+
+public:
+  FieldSet(const Shape &s) { this->resize(s); }
+  FieldSet() {}
+
+  FieldSet &resize(const Shape &s) {
+    if constexpr (L == Layout::SOA) {
+      for (auto &f : this->storage) {
+        f.resize(s);
+      }
+    } else {
+      this->storage.resize(s);
+    }
+    this->dims = s;
+    return *this;
+  }
+
+  inline const Shape &shape() const { return this->dims; }
+
+  /* Underlying storage, e.g. for writers that handle both layouts */
+  inline const Storage &data() const noexcept { return this->storage; }
+
+  /* Component access (SOA only) */
+  inline Field &field(const std::size_t k) noexcept {
+    static_assert(L == Layout::SOA, "field() requires Layout::SOA; use load/store instead");
+    return this->storage[k];
+  }
+  inline const Field &field(const std::size_t k) const noexcept {
+    static_assert(L == Layout::SOA, "field() requires Layout::SOA; use load/store instead");
+    return this->storage[k];
+  }
+
+  /* Copy a single component from/to a plain Tensor, e.g. to run a filter on it */
+  FieldSet &load(const std::size_t k, const Field &src) {
+    if (k >= M) {
+      throw std::invalid_argument("invalid component index");
+    }
+    if constexpr (L == Layout::SOA) {
+      this->storage[k] = src;
+    } else {
+      if (this->shape() != src.shape()) {
+        throw std::invalid_argument("invalid dimensions");
+      }
+      zip_recurse<N>([k](point_type &p, const T &v) { p[k] = v; }, this->storage, src);
+    }
+    return *this;
+  }
+
+  const FieldSet &store(const std::size_t k, Field &dst) const {
+    if (k >= M) {
+      throw std::invalid_argument("invalid component index");
+    }
+    if constexpr (L == Layout::SOA) {
+      dst = this->storage[k];
+    } else {
+      if (this->shape() != dst.shape()) {
+        throw std::invalid_argument("invalid dimensions");
+      }
+      zip_recurse<N>([k](T &v, const point_type &p) { v = p[k]; }, dst, this->storage);
+    }
+    return *this;
+  }
+
+  FieldSet &fill(const point_type &v) {
+    if constexpr (L == Layout::SOA) {
+      for (std::size_t k = 0; k < M; ++k) {
+        this->storage[k].fill(v[k]);
+      }
+    } else {
+      this->storage.fill(v);
+    }
+    return *this;
+  }
+
+  /*
+   * Apply a functor point-wise over all components in a single sweep.
+   * The functor receives `point_type &` for this FieldSet and `const point_type &` for each of
+   * the others, so every component of a grid point is updated together.
+   */
+  template <typename F, typename... FieldSets>
+  FieldSet &map(F &&f, const FieldSets &...others) noexcept {
+    static_assert((std::is_same_v<std::decay_t<FieldSets>, FieldSet> && ...));
+
+    if constexpr (L == Layout::SOA) {
+      map_recurse<N>(f, pointers(this->storage), pointers(others.storage)...);
+    } else {
+      this->storage.map(std::forward<F>(f), others.storage...);
+    }
+
+    return *this;
+  }
+
+  template <typename F, typename... FieldSets>
+  FieldSet &map_safe(F &&f, const FieldSets &...others) {
+    static_assert((std::is_same_v<std::decay_t<FieldSets>, FieldSet> && ...));
+    if (((this->shape() != others.shape()) || ...)) {
+      throw std::invalid_argument("invalid dimensions");
+    }
+
+    return this->map(std::forward<F>(f), others...);
+  }
+
+  bool operator==(const FieldSet &rhs) const {
+    return this->dims == rhs.dims && this->storage == rhs.storage;
+  }
+  bool operator!=(const FieldSet &rhs) const { return !((*this) == rhs); }
+
+private:
+  template <typename U>
+  static std::array<U *, M> pointers(std::array<U, M> &a) {
+    std::array<U *, M> ret;
+    for (std::size_t k = 0; k < M; ++k) {
+      ret[k] = &a[k];
+    }
+    return ret;
+  }
+
+  template <typename U>
+  static std::array<const U *, M> pointers(const std::array<U, M> &a) {
+    std::array<const U *, M> ret;
+    for (std::size_t k = 0; k < M; ++k) {
+      ret[k] = &a[k];
+    }
+    return ret;
+  }
+
+  template <typename U>
+  static auto sub(const std::array<U *, M> &a, const std::size_t i) {
+    std::array<std::remove_reference_t<decltype((*a[0])[i])> *, M> ret;
+    for (std::size_t k = 0; k < M; ++k) {
+      ret[k] = &(*a[k])[i];
+    }
+    return ret;
+  }
+
+  template <typename U>
+  static point_type gather(const std::array<U *, M> &a, const std::size_t i) {
+    point_type ret;
+    for (std::size_t k = 0; k < M; ++k) {
+      ret[k] = (*a[k])[i];
+    }
+    return ret;
+  }
+
+  /* Walk two nested tensors of different scalar types in lock-step */
+  template <std::size_t D, typename F, typename A, typename B>
+  static void zip_recurse(const F &f, A &a, const B &b) {
+#pragma omp parallel for if (D == N)
+    for (std::size_t i = 0; i < a.shape()[0]; ++i) {
+      if constexpr (D > 1) {
+        zip_recurse<D - 1>(f, a[i], b[i]);
+      } else {
+        f(a[i], b[i]);
+      }
+    }
+  }
+
+  /* Walk the components of a SOA set in lock-step; only the outermost dimension is parallel */
+  template <std::size_t D, typename F, typename... Others>
+  static void map_recurse(F &f, const std::array<Tensor<T, D> *, M> &self,
+                          const Others &...others) {
+    const std::size_t n = self[0]->shape()[0];
+#pragma omp parallel for if (D == N)
+    for (std::size_t i = 0; i < n; ++i) {
+      if constexpr (D > 1) {
+        map_recurse<D - 1>(f, sub(self, i), sub(others, i)...);
+      } else {
+        point_type p = gather(self, i);
+        f(p, gather(others, i)...);
+        for (std::size_t k = 0; k < M; ++k) {
+          (*self[k])[i] = p[k];
+        }
+      }
+    }
+  }
+};
+} // namespace libtensor
+
+#endif
@@ -6,6 +6,11 @@
 #ifndef __LIBTENSOR__CORE__FUNCTOR__
 #define __LIBTENSOR__CORE__FUNCTOR__
 
+#include "math.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <type_traits>
 
 namespace libtensor::functor {
@@ -26,6 +31,106 @@ struct NegSingFunctor {
   inline void operator()(T &ret) const { ret = -ret; }
 };
 
+/*
+ * Element-wise math. Each functor either updates in place, f(x), or writes f(arg) to ret, so it can
+ * be passed to Tensor::map as `t.map(F())` or `ret.map(F(), t)`. The kernels in math.hh are
+ * branch-free and inline, hence these functors vectorise under `#pragma omp simd`. Where the
+ * kernels do not vectorise (math::vectorised), the standard library is called instead.
+ */
+template <typename T>
+struct ExpFunctor {
+  using value_type = T;
+  static LIBTENSOR_INLINE T f(const T x) {
+    if constexpr (math::vectorised<T>) {
+      return math::exp(x);
+    } else {
+      return std::exp(x);
+    }
+  }
+  inline void operator()(T &ret) const { ret = f(ret); }
+  inline void operator()(T &ret, const T &x) const { ret = f(x); }
+};
+
+template <typename T>
+struct LogFunctor {
+  using value_type = T;
+  static LIBTENSOR_INLINE T f(const T x) {
+    if constexpr (math::vectorised<T>) {
+      return math::log(x);
+    } else {
+      return std::log(x);
+    }
+  }
+  inline void operator()(T &ret) const { ret = f(ret); }
+  inline void operator()(T &ret, const T &x) const { ret = f(x); }
+};
+
+template <typename T>
+struct TanhFunctor {
+  using value_type = T;
+  static LIBTENSOR_INLINE T f(const T x) {
+    if constexpr (math::vectorised<T>) {
+      return math::tanh(x);
+    } else {
+      return std::tanh(x);
+    }
+  }
+  inline void operator()(T &ret) const { ret = f(ret); }
+  inline void operator()(T &ret, const T &x) const { ret = f(x); }
+};
+
+template <typename T, int E>
+struct PowFunctor {
+  using value_type = T;
+  inline void operator()(T &ret) const { ret = math::powi<E>(ret); }
+  inline void operator()(T &ret, const T &x) const { ret = math::powi<E>(x); }
+};
+
+template <typename T>
+struct ClampFunctor {
+  using value_type = T;
+  const T lo, hi;
+  ClampFunctor(const T l, const T h) : lo(l), hi(h) {}
+  LIBTENSOR_INLINE T f(const T x) const {
+    if constexpr (math::vectorised<T>) {
+      return math::clamp(x, lo, hi);
+    } else {
+      // Also passes NaN through
+      return std::min(std::max(x, lo), hi);
+    }
+  }
+  inline void operator()(T &ret) const { ret = f(ret); }
+  inline void operator()(T &ret, const T &x) const { ret = f(x); }
+};
+
+/* c[0] + c[1] * x + ... + c[K - 1] * x^(K - 1), evaluated by Horner's scheme */
+template <typename T, std::size_t K>
+struct PolyFunctor {
+  using value_type = T;
+  const std::array<T, K> coeffs;
+  PolyFunctor(const std::array<T, K> &c) : coeffs(c) {}
+  inline void operator()(T &ret) const { ret = math::horner(coeffs, ret); }
+  inline void operator()(T &ret, const T &x) const { ret = math::horner(coeffs, x); }
+};
+
+/* Derivative of the double-well potential (phi^2 - 1)^2 / 4: phi^3 - phi */
+template <typename T>
+struct DoubleWellFunctor {
+  using value_type = T;
+  inline void operator()(T &ret) const { ret = ret * (ret * ret - T{1}); }
+  inline void operator()(T &ret, const T &phi) const { ret = phi * (phi * phi - T{1}); }
+};
+
+/* Interpolation function h(phi) = phi^3 (6 phi^2 - 15 phi + 10) */
+template <typename T>
+struct InterpFunctor {
+  using value_type = T;
+  inline void operator()(T &ret) const { (*this)(ret, T(ret)); }
+  inline void operator()(T &ret, const T &phi) const {
+    ret = phi * phi * phi * ((T{6} * phi - T{15}) * phi + T{10});
+  }
+};
+
 /* Binary Functor */
 template <typename T>
 struct DiffFunctor {
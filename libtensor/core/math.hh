@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LIBTENSOR__CORE__MATH__
+#define __LIBTENSOR__CORE__MATH__
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+/* The kernels are only vectorised once inlined into the calling loop, which -O2 does not do */
+#if defined(__GNUC__)
+#define LIBTENSOR_INLINE inline __attribute__((always_inline))
+#else
+#define LIBTENSOR_INLINE inline
+#endif
+
+/* The double kernels need 64-bit lane compares, which x86 only has from SSE4.2 (x86-64-v2) */
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && \
+    !defined(__SSE4_2__) && !defined(__AVX__)
+#define LIBTENSOR_SIMD_DOUBLE 0
+#else
+#define LIBTENSOR_SIMD_DOUBLE 1
+#endif
+
+/*
+ * Branch-free scalar kernels meant to be inlined into `#pragma omp simd` loops (e.g. Tensor::map),
+ * where libm calls would stop vectorisation. Only float and double are supported.
+ * Special cases are resolved with bit masks rather than conditionals on floating-point values,
+ * which compilers refuse to if-convert unless trapping math is disabled.
+ */
+namespace libtensor::math {
+/* Whether the kernels vectorise for T on the target; otherwise they are slower than libm */
+template <typename T>
+inline constexpr bool vectorised = !std::is_same_v<T, double> || LIBTENSOR_SIMD_DOUBLE;
+
+template <typename T>
+struct Traits;
+
+template <>
+struct Traits<double> {
+  using Int = std::int64_t;
+  using UInt = std::uint64_t;
+  static constexpr int mantissa = 52;
+  static constexpr Int bias = 1023;
+  static constexpr double exp_lo = -746.0;
+  static constexpr double exp_hi = 710.0;
+  static constexpr double ln2_hi = 6.93147180369123816490e-01;
+  static constexpr double ln2_lo = 1.90821492927058770002e-10;
+  static constexpr std::size_t exp_terms = 14;
+  static constexpr std::size_t log_terms = 11;
+};
+
+template <>
+struct Traits<float> {
+  using Int = std::int32_t;
+  using UInt = std::uint32_t;
+  static constexpr int mantissa = 23;
+  static constexpr Int bias = 127;
+  static constexpr float exp_lo = -104.0f;
+  static constexpr float exp_hi = 89.0f;
+  static constexpr float ln2_hi = 6.9313812256e-01f;
+  static constexpr float ln2_lo = 9.0580006145e-06f;
+  static constexpr std::size_t exp_terms = 8;
+  static constexpr std::size_t log_terms = 5;
+};
+
+template <typename To, typename From>
+LIBTENSOR_INLINE To bit_cast(const From &v) noexcept {
+  static_assert(sizeof(To) == sizeof(From));
+  To ret;
+  std::memcpy(&ret, &v, sizeof(To));
+  return ret;
+}
+
+/* a if c else b, as a bitwise blend */
+template <typename T>
+LIBTENSOR_INLINE T select(const bool c, const T a, const T b) noexcept {
+  using UInt = typename Traits<T>::UInt;
+  const UInt m = UInt{0} - static_cast<UInt>(c);
+  return bit_cast<T>((bit_cast<UInt>(a) & m) | (bit_cast<UInt>(b) & ~m));
+}
+
+/* c[0] + c[1] * x + ... + c[K - 1] * x^(K - 1), unrolled at compile time */
+template <typename T, std::size_t K, std::size_t I = 0>
+LIBTENSOR_INLINE T horner(const std::array<T, K> &c, const T x) noexcept {
+  static_assert(I < K);
+  if constexpr (I + 1 == K) {
+    return c[I];
+  } else {
+    return c[I] + x * horner<T, K, I + 1>(c, x);
+  }
+}
+
+/* x^E for a compile-time integer exponent, by repeated squaring */
+template <int E, typename T>
+LIBTENSOR_INLINE T powi(const T x) noexcept {
+  if constexpr (E < 0) {
+    return T{1} / powi<-E>(x);
+  } else if constexpr (E == 0) {
+    return T{1};
+  } else if constexpr (E % 2 == 0) {
+    const T h = powi<E / 2>(x);
+    return h * h;
+  } else {
+    return x * powi<E - 1>(x);
+  }
+}
+
+/* NaN is passed through */
+template <typename T>
+LIBTENSOR_INLINE T clamp(const T x, const T lo, const T hi) noexcept {
+  return select(x < lo, lo, select(x > hi, hi, x));
+}
+
+/* Taylor coefficients 1 / (k + S)! of (e^x - sum_{k < S} x^k / k!) / x^S */
+template <typename T, std::size_t K, std::size_t S = 0>
+constexpr std::array<T, K> exp_series() {
+  std::array<T, K> c{};
+  T f = T{1};
+  for (std::size_t k = 1; k <= S; ++k) {
+    f *= static_cast<T>(k);
+  }
+  for (std::size_t k = 0; k < K; ++k) {
+    c[k] = T{1} / f;
+    f *= static_cast<T>(k + S + 1);
+  }
+  return c;
+}
+
+/* Coefficients 1 / (2k + 1) of atanh(s) / s in powers of s^2 */
+template <typename T, std::size_t K>
+constexpr std::array<T, K> atanh_series() {
+  std::array<T, K> c{};
+  for (std::size_t k = 0; k < K; ++k) {
+    c[k] = T{1} / static_cast<T>(2 * k + 1);
+  }
+  return c;
+}
+
+/* x * 2^k for integral k in roughly [-2 * bias, 2 * bias], built from the exponent bits */
+template <typename T>
+LIBTENSOR_INLINE T ldexp(const T x, const std::int32_t k) noexcept {
+  using Tr = Traits<T>;
+  using UInt = typename Tr::UInt;
+  const auto k1 = k / 2;
+  const auto k2 = k - k1;
+  const T f1 = bit_cast<T>(static_cast<UInt>(k1 + Tr::bias) << Tr::mantissa);
+  const T f2 = bit_cast<T>(static_cast<UInt>(k2 + Tr::bias) << Tr::mantissa);
+  return (x * f1) * f2;
+}
+
+/* e^x with a relative error of about 1 ulp */
+template <typename T>
+LIBTENSOR_INLINE T exp(const T x) noexcept {
+  using Tr = Traits<T>;
+  using Int = typename Tr::Int;
+  constexpr auto c = exp_series<T, Tr::exp_terms>();
+  constexpr T log2e = T(1.44269504088896340736);
+  // Adding 1.5 * 2^mantissa rounds to the nearest integer, which then sits in the low bits
+  constexpr T shifter = T(3) * T(Int{1} << (Tr::mantissa - 1));
+  const T xc = clamp(x, Tr::exp_lo, Tr::exp_hi);
+  // x = k * ln2 + r, |r| <= ln2 / 2
+  const T t = xc * log2e + shifter;
+  const auto k = static_cast<std::int32_t>(bit_cast<Int>(t) - bit_cast<Int>(shifter));
+  const T kf = t - shifter;
+  const T r = (xc - kf * Tr::ln2_hi) - kf * Tr::ln2_lo;
+  // A NaN propagates through r
+  return ldexp(horner(c, r), k);
+}
+
+/* Natural logarithm with a relative error of a few ulp; log(0) = -inf, log(x < 0) = NaN */
+template <typename T>
+LIBTENSOR_INLINE T log(const T x) noexcept {
+  using Tr = Traits<T>;
+  using UInt = typename Tr::UInt;
+  constexpr auto c = atanh_series<T, Tr::log_terms>();
+  constexpr UInt mmask = (UInt{1} << Tr::mantissa) - 1;
+  constexpr std::int32_t emask = (1 << (sizeof(T) * 8 - 1 - Tr::mantissa)) - 1;
+  constexpr std::int32_t shift = Tr::mantissa + 2;
+  constexpr std::int32_t bias = Tr::bias;
+  constexpr T inf = std::numeric_limits<T>::infinity();
+  constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+  constexpr T sqrt2 = T(1.41421356237309504880);
+  // Scale subnormals into the normal range
+  const bool sub = x < std::numeric_limits<T>::min();
+  const UInt bits = bit_cast<UInt>(select(sub, x * T(std::uint64_t{1} << shift), x));
+  // Integer work stays in 32-bit lanes, as 64-bit compares and conversions need AVX-512
+  const auto eb = static_cast<std::int32_t>(bits >> Tr::mantissa) & emask;
+  // x = 2^e * m with m in [sqrt(2) / 2, sqrt(2))
+  const T m1 = bit_cast<T>((bits & mmask) | (static_cast<UInt>(bias) << Tr::mantissa));
+  const bool big = m1 > sqrt2;
+  const T m = select(big, m1 * T{0.5}, m1);
+  const std::int32_t e = eb - bias - shift * sub + big;
+  // log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1)
+  const T s = (m - T{1}) / (m + T{1});
+  const T p = horner(c, s * s);
+  const T ef = static_cast<T>(e);
+  const T ret = ef * Tr::ln2_hi + (T{2} * s * p + ef * Tr::ln2_lo);
+  // +inf and NaN map to themselves, zero to -inf and negative numbers to NaN
+  const T special = select(x == T{0}, -inf, select(x < T{0}, nan, x));
+  return select((x > T{0}) & (x < inf), ret, special);
+}
+
+/* e^x - 1, accurate also for |x| << 1 */
+template <typename T>
+LIBTENSOR_INLINE T expm1(const T x) noexcept {
+  using Tr = Traits<T>;
+  constexpr auto c = exp_series<T, Tr::exp_terms, 1>();
+  // Below ln2 / 2 the reduction of exp is the identity, so the series is used directly
+  const T small = x * horner(c, x);
+  return select((x < T{0.34}) & (x > T{-0.34}), small, exp(x) - T{1});
+}
+
+/* Hyperbolic tangent with a relative error of a few ulp */
+template <typename T>
+LIBTENSOR_INLINE T tanh(const T x) noexcept {
+  using UInt = typename Traits<T>::UInt;
+  constexpr UInt smask = UInt{1} << (sizeof(T) * 8 - 1);
+  const UInt ix = bit_cast<UInt>(x);
+  // tanh(20) == 1 to double precision
+  const T a = clamp(bit_cast<T>(ix & ~smask), T{0}, T{20});
+  const T em1 = expm1(T{2} * a);
+  // tanh is odd
+  return bit_cast<T>(bit_cast<UInt>(em1 / (em1 + T{2})) | (ix & smask));
+}
+} // namespace libtensor::math
+
+#endif
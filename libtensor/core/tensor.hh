@@ -10,9 +10,11 @@
 #include "functor.hh"
 #include "shape.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -37,10 +39,7 @@ private:
   std::vector<value_type> data = {value_type{}};
 
 public:
-  Tensor(const Tensor &&t) {
-    this->resize(t.shape());
-    *this = t;
-  }
+  Tensor(Tensor &&t) noexcept : dims(t.dims), data(std::move(t.data)) { t.dims = Shape{}; }
   Tensor(const Tensor &t) {
     this->resize(t.shape());
     *this = t;
@@ -59,23 +58,113 @@ public:
     return *this;
   }
 
+  /*
+   * Elements inside both the old and the new shape keep their values and newly exposed ones are
+   * zero, on every axis. Storage is reused per row, so a reshape such as {4, 8} -> {8, 4} still
+   * allocates the rows beyond the old extent.
+   */
   void resize_recurse(const Shape &s) {
+    const auto extent = this->dims[0];
     this->dims = s;
-    this->data.resize(this->dims[0]);
 
     // If the tensor is not the base, resize recursively
     if constexpr (n_dims > 1) {
+      // Sub-tensors past the extent are kept with their storage, so regrowing does not allocate
+      if (this->data.size() < this->dims[0]) {
+        this->data.resize(this->dims[0]);
+      }
       SubShape ss;
       std::copy(std::next(this->dims.begin()), this->dims.end(), ss.begin());
 #pragma omp parallel for
       for (std::size_t i = 0; i < this->dims[0]; ++i) {
-        this->data.at(i).resize_recurse(ss);
+        this->data[i].resize_recurse(ss);
+        // Kept sub-tensors past the old extent still hold their stale values
+        if (i >= extent) {
+          this->data[i].fill(T{});
+        }
+      }
+    } else {
+      // Shrinking a std::vector keeps its capacity and growing value-initialises
+      this->data.resize(this->dims[0]);
+    }
+  }
+
+  /* Allocate storage for shape `s` without changing the shape; resizing within it is then free */
+  Tensor &reserve(const Shape &s) {
+    if constexpr (n_dims > 1) {
+      if (this->data.size() < s[0]) {
+        this->data.resize(s[0]);
+      }
+      SubShape ss;
+      std::copy(std::next(s.begin()), s.end(), ss.begin());
+#pragma omp parallel for
+      for (std::size_t i = 0; i < s[0]; ++i) {
+        this->data[i].reserve(ss);
+      }
+    } else {
+      this->data.reserve(s[0]);
+    }
+    return *this;
+  }
+
+  /* Release the storage kept by resize and reserve beyond the current shape */
+  Tensor &shrink_to_fit() {
+    if constexpr (n_dims > 1) {
+      this->data.erase(this->data.begin() + this->dims[0], this->data.end());
+      for (auto &sub : this->data) {
+        sub.shrink_to_fit();
       }
     }
+    this->data.shrink_to_fit();
+    return *this;
   }
 
   inline const Shape &shape() const { return this->dims; }
 
+  /* Total number of scalar elements */
+  inline std::size_t size() const {
+    std::size_t n = 1;
+    for (const auto d : this->dims) {
+      n *= d;
+    }
+    return n;
+  }
+
+  /* Copy the scalars with flat (row-major) indices [begin, end) to/from a contiguous buffer */
+  void copy_to(const std::size_t begin, const std::size_t end, T *out) const {
+    if (begin >= end) {
+      return;
+    }
+    if constexpr (n_dims > 1) {
+      const std::size_t stride = this->size() / this->dims[0];
+      for (std::size_t i = begin / stride; i * stride < end; ++i) {
+        const std::size_t lo = std::max(begin, i * stride);
+        const std::size_t hi = std::min(end, (i + 1) * stride);
+        (*this)[i].copy_to(lo - i * stride, hi - i * stride, out);
+        out += hi - lo;
+      }
+    } else {
+      std::copy(this->data.begin() + begin, this->data.begin() + end, out);
+    }
+  }
+
+  void copy_from(const std::size_t begin, const std::size_t end, const T *in) {
+    if (begin >= end) {
+      return;
+    }
+    if constexpr (n_dims > 1) {
+      const std::size_t stride = this->size() / this->dims[0];
+      for (std::size_t i = begin / stride; i * stride < end; ++i) {
+        const std::size_t lo = std::max(begin, i * stride);
+        const std::size_t hi = std::min(end, (i + 1) * stride);
+        (*this)[i].copy_from(lo - i * stride, hi - i * stride, in);
+        in += hi - lo;
+      }
+    } else {
+      std::copy(in, in + (end - begin), this->data.begin() + begin);
+    }
+  }
+
   template <typename F, typename... Tensors>
   Tensor &map(F &&f, const Tensors &...others) noexcept {
     static_assert((std::is_same_v<std::decay_t<Tensors>, Tensor> && ...));
@@ -99,11 +188,29 @@ public:
 
   template <typename F, typename... Tensors>
   void map_recurse(F &&f, const Tensors &...others) {
+    if constexpr (n_dims > 1) {
 #pragma omp parallel for
-    for (std::size_t i = 0; i < this->dims[0]; ++i) {
-      if constexpr (n_dims > 1) {
-        (*this)[i].map_recurse(std::forward<F>(f), (others[i])...);
-      } else {
+      for (std::size_t i = 0; i < this->dims[0]; ++i) {
+        (*this)[i].map_rows(std::forward<F>(f), (others[i])...);
+      }
+    } else {
+#pragma omp parallel for simd
+      for (std::size_t i = 0; i < this->dims[0]; ++i) {
+        f((*this)[i], (others[i])...);
+      }
+    }
+  }
+
+  /* Below the parallel axis; the contiguous innermost rows are left to vectorise */
+  template <typename F, typename... Tensors>
+  void map_rows(F &&f, const Tensors &...others) {
+    if constexpr (n_dims > 1) {
+      for (std::size_t i = 0; i < this->dims[0]; ++i) {
+        (*this)[i].map_rows(std::forward<F>(f), (others[i])...);
+      }
+    } else {
+#pragma omp simd
+      for (std::size_t i = 0; i < this->dims[0]; ++i) {
         f((*this)[i], (others[i])...);
       }
     }
@@ -125,9 +232,20 @@ public:
 
   /* Getter and Setter */
   inline value_type &operator[](const std::size_t i) noexcept { return this->data[i]; }
-  inline value_type &at(const std::size_t i) { return this->data.at(i); }
+  // The storage may hold more sub-tensors than the shape, so bounds are checked on the shape
+  inline value_type &at(const std::size_t i) {
+    if (i >= this->dims[0]) {
+      throw std::out_of_range("index out of range");
+    }
+    return this->data[i];
+  }
   inline const value_type &operator[](const std::size_t i) const noexcept { return this->data[i]; };
-  inline const value_type at(const std::size_t i) const { return this->data.at(i); };
+  inline const value_type at(const std::size_t i) const {
+    if (i >= this->dims[0]) {
+      throw std::out_of_range("index out of range");
+    }
+    return this->data[i];
+  };
 
   /* Unary operators */
   Tensor operator+() const { return (*this); }
@@ -251,6 +369,85 @@ public:
     return os;
   }
 };
+
+/*
+ * Operators writing into a caller-provided tensor instead of a new one, e.g. add(out, a, b) for
+ * out = a + b. `out` is resized to the shape of the operands, reusing its storage, and may be
+ * one of the operands.
+ */
+template <typename T, std::size_t N, typename F, typename... Tensors>
+Tensor<T, N> &map_into(Tensor<T, N> &out, F &&f, const Tensor<T, N> &first,
+                       const Tensors &...others) {
+  if (((others.shape() != first.shape()) || ...)) {
+    throw std::invalid_argument("invalid dimensions");
+  }
+  return out.resize(first.shape()).map(std::forward<F>(f), first, others...);
+}
+
+template <typename T, std::size_t N>
+Tensor<T, N> &neg(Tensor<T, N> &out, const Tensor<T, N> &t) {
+  return map_into(out, [](T &ret, const T &x) { ret = -x; }, t);
+}
+
+template <typename T, std::size_t N>
+Tensor<T, N> &add(Tensor<T, N> &out, const Tensor<T, N> &lhs, const Tensor<T, N> &rhs) {
+  return map_into(out, functor::SumFunctor<T>(), lhs, rhs);
+}
+template <typename T, std::size_t N>
+Tensor<T, N> &add(Tensor<T, N> &out, const Tensor<T, N> &lhs,
+                  const typename Tensor<T, N>::scalar_type &rhs) {
+  return map_into(out, functor::BindRhsWrapper<functor::SumFunctor<T>>(rhs), lhs);
+}
+template <typename T, std::size_t N>
+Tensor<T, N> &add(Tensor<T, N> &out, const typename Tensor<T, N>::scalar_type &lhs,
+                  const Tensor<T, N> &rhs) {
+  return map_into(out, functor::BindLhsWrapper<functor::SumFunctor<T>>(lhs), rhs);
+}
+
+template <typename T, std::size_t N>
+Tensor<T, N> &sub(Tensor<T, N> &out, const Tensor<T, N> &lhs, const Tensor<T, N> &rhs) {
+  return map_into(out, functor::DiffFunctor<T>(), lhs, rhs);
+}
+template <typename T, std::size_t N>
+Tensor<T, N> &sub(Tensor<T, N> &out, const Tensor<T, N> &lhs,
+                  const typename Tensor<T, N>::scalar_type &rhs) {
+  return map_into(out, functor::BindRhsWrapper<functor::DiffFunctor<T>>(rhs), lhs);
+}
+template <typename T, std::size_t N>
+Tensor<T, N> &sub(Tensor<T, N> &out, const typename Tensor<T, N>::scalar_type &lhs,
+                  const Tensor<T, N> &rhs) {
+  return map_into(out, functor::BindLhsWrapper<functor::DiffFunctor<T>>(lhs), rhs);
+}
+
+template <typename T, std::size_t N>
+Tensor<T, N> &mul(Tensor<T, N> &out, const Tensor<T, N> &lhs, const Tensor<T, N> &rhs) {
+  return map_into(out, functor::ProdFunctor<T>(), lhs, rhs);
+}
+template <typename T, std::size_t N>
+Tensor<T, N> &mul(Tensor<T, N> &out, const Tensor<T, N> &lhs,
+                  const typename Tensor<T, N>::scalar_type &rhs) {
+  return map_into(out, functor::BindRhsWrapper<functor::ProdFunctor<T>>(rhs), lhs);
+}
+template <typename T, std::size_t N>
+Tensor<T, N> &mul(Tensor<T, N> &out, const typename Tensor<T, N>::scalar_type &lhs,
+                  const Tensor<T, N> &rhs) {
+  return map_into(out, functor::BindLhsWrapper<functor::ProdFunctor<T>>(lhs), rhs);
+}
+
+template <typename T, std::size_t N>
+Tensor<T, N> &div(Tensor<T, N> &out, const Tensor<T, N> &lhs, const Tensor<T, N> &rhs) {
+  return map_into(out, functor::DivFunctor<T>(), lhs, rhs);
+}
+template <typename T, std::size_t N>
+Tensor<T, N> &div(Tensor<T, N> &out, const Tensor<T, N> &lhs,
+                  const typename Tensor<T, N>::scalar_type &rhs) {
+  return map_into(out, functor::BindRhsWrapper<functor::DivFunctor<T>>(rhs), lhs);
+}
+template <typename T, std::size_t N>
+Tensor<T, N> &div(Tensor<T, N> &out, const typename Tensor<T, N>::scalar_type &lhs,
+                  const Tensor<T, N> &rhs) {
+  return map_into(out, functor::BindLhsWrapper<functor::DivFunctor<T>>(lhs), rhs);
+}
 } // namespace libtensor
 
 #endif
@@ -8,9 +8,31 @@
 
 #include "libtensor.hh"
 
+#include <cstdint>
+
 namespace libtensor {
 enum class BorderType { INTERNAL, CONSTANT, REPLICATE, REFLECT, WRAP };
 
+/*
+ * Map index `i` of an axis of length `n` back onto the grid according to the border type.
+ * Returns -1 when the value has to be taken from outside the grid (CONSTANT, INTERNAL).
+ */
+template <BorderType BT>
+inline int64_t border_index(const int64_t i, const int64_t n) noexcept {
+  if (i >= 0 && i < n) {
+    return i;
+  }
+  if constexpr (BT == BorderType::REPLICATE) {
+    return i < 0 ? 0 : n - 1;
+  } else if constexpr (BT == BorderType::REFLECT) {
+    return i < 0 ? -i : 2 * (n - 1) - i;
+  } else if constexpr (BT == BorderType::WRAP) {
+    return ((i % n) + n) % n;
+  } else {
+    return -1;
+  }
+}
+
 template <typename T, BorderType BT = BorderType::REFLECT>
 void conv2d(const Tensor<T, 2> &tensor, const Tensor<T, 2> &filter, Tensor<T, 2> &ret,
             [[maybe_unused]] T cst = T{}) {
@@ -31,7 +53,7 @@ void conv2d(const Tensor<T, 2> &tensor, const Tensor<T, 2> &filter, Tensor<T, 2>
     for (std::size_t j = 1; j < t_shape[1] - 1; ++j) {
       for (int64_t m = 0; m < static_cast<int64_t>(f_shape[0]); ++m) {
         for (int64_t n = 0; n < static_cast<int64_t>(f_shape[1]); ++n) {
-          ret[i][j] += (tensor[i + m - 1][j + n - 1] * filter[n][m]);
+          ret[i][j] += (tensor[i + m - 1][j + n - 1] * filter[m][n]);
         }
       }
     }
@@ -6,7 +6,9 @@
 #ifndef __LIBTENSOR__LIBTENSOR__
 #define __LIBTENSOR__LIBTENSOR__
 
+#include "core/fieldset.hh"
 #include "core/functor.hh"
+#include "core/math.hh"
 #include "core/shape.hh"
 #include "core/tensor.hh"
 
@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LIBTENSOR__IMPL__MULTIGRID__
+#define __LIBTENSOR__IMPL__MULTIGRID__
+
+#include "filter.hh"
+#include "libtensor.hh"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace libtensor {
+enum class CycleType { V, W, F };
+enum class SmootherType { RED_BLACK_GAUSS_SEIDEL, JACOBI };
+
+/*
+ * Geometric multigrid solver for
+ *   alpha * u - beta * laplacian(u) = f
+ * on a 2D/3D grid of spacing h, discretised with the standard 5/7-point Laplacian. Points outside
+ * the grid follow the border type; CONSTANT uses `cst` as the ghost value (Dirichlet).
+ *
+ * Poisson: alpha = 0, beta = -1 solves laplacian(u) = f. Implicit diffusion: alpha = 1,
+ * beta = dt * D. Grids are coarsened by a factor 2 while every extent is even, so sizes divisible
+ * by a power of two give the best convergence. The hierarchy is allocated once and reused by
+ * every call to solve.
+ */
+template <typename T, std::size_t N, BorderType BT = BorderType::REFLECT>
+class Multigrid {
+  static_assert(N == 2 || N == 3, "Multigrid supports 2D and 3D grids");
+  static_assert(BT != BorderType::INTERNAL, "Multigrid requires a border rule");
+
+public:
+  using Shape = libtensor::Shape<N>;
+
+  struct Options {
+    CycleType cycle = CycleType::V;
+    SmootherType smoother = SmootherType::RED_BLACK_GAUSS_SEIDEL;
+    std::size_t pre = 2;
+    std::size_t post = 2;
+    std::size_t coarse = 50;
+    std::size_t max_iter = 100;
+    T tol = T{1e-10};
+    T omega = T{0.8};
+  };
+
+private:
+  struct Level {
+    Shape dims;
+    std::size_t size;
+    T h2inv;
+    // Points outside the grid are ghosts, even where the border type maps them onto the grid
+    bool ghosts;
+    // Ghost = g + gs * (adjacent value) + gm * (value opposite the adjacent one): keeps the
+    // Dirichlet location of CONSTANT and the mirror plane of REFLECT fixed on coarse levels
+    T g, gs, gm;
+    std::vector<T> u, f, r;
+  };
+
+  using RowOffsets = std::array<int64_t, 2 * (N - 1)>;
+
+  T alpha, beta, cst;
+  Options opts;
+  std::vector<Level> levels;
+  T res = T{0};
+
+public:
+  Multigrid(const Shape &s, const T h = T{1}, const T a = T{0}, const T b = T{-1},
+            const T c = T{}, const Options &o = {})
+      : alpha(a), beta(b), cst(c), opts(o) {
+    Shape dims = s;
+    T h2inv = T{1} / (h * h);
+    // Distance from the outermost cell centre to the Dirichlet location (one spacing out) or to
+    // the mirror plane of REFLECT (the outermost point) in units of the spacing
+    T dist = (BT == BorderType::CONSTANT) ? T{1} : T{0};
+    while (true) {
+      Level l;
+      l.dims = dims;
+      l.size = 1;
+      for (std::size_t d = 0; d < N; ++d) {
+        l.size *= dims[d];
+      }
+      l.h2inv = h2inv;
+      // Coarse REFLECT levels mirror their values about a plane that is no longer a grid point
+      l.ghosts = (BT == BorderType::REFLECT) && !this->levels.empty();
+      l.g = (BT == BorderType::CONSTANT && this->levels.empty()) ? this->cst : T{0};
+      if constexpr (BT == BorderType::CONSTANT) {
+        l.gs = T{1} - T{1} / dist;
+        l.gm = T{0};
+      } else if constexpr (BT == BorderType::REFLECT) {
+        // The ghost is the linear interpolation at its mirror image about the plane
+        l.gs = T{2} * dist;
+        l.gm = T{1} - T{2} * dist;
+      } else {
+        l.gs = l.gm = T{0};
+      }
+      l.u.resize(l.size);
+      l.f.resize(l.size);
+      l.r.resize(l.size);
+      this->levels.push_back(std::move(l));
+
+      bool coarsen = true;
+      for (std::size_t d = 0; d < N; ++d) {
+        coarsen = coarsen && (dims[d] % 2 == 0) && (dims[d] >= 4);
+      }
+      if (!coarsen) {
+        break;
+      }
+      for (std::size_t d = 0; d < N; ++d) {
+        dims[d] /= 2;
+      }
+      h2inv /= T{4};
+      dist = (dist + T{0.5}) / T{2};
+    }
+  }
+
+  inline const Shape &shape() const { return this->levels[0].dims; }
+  inline std::size_t n_levels() const { return this->levels.size(); }
+  inline Options &options() { return this->opts; }
+  inline const Options &options() const { return this->opts; }
+  /* L2 norm of the residual after the last solve */
+  inline T residual() const { return this->res; }
+
+  /* Solve in place, using `u` as initial guess. Returns the number of cycles performed */
+  std::size_t solve(Tensor<T, N> &u, const Tensor<T, N> &f) {
+    if (u.shape() != this->shape() || f.shape() != this->shape()) {
+      throw std::invalid_argument("invalid dimensions");
+    }
+    auto &fine = this->levels[0];
+    copy_in(u, fine.u);
+    copy_in(f, fine.f);
+
+    this->residual(0);
+    const T r0 = norm(fine.r);
+    this->res = r0;
+    std::size_t it = 0;
+    while (it < this->opts.max_iter && this->res > this->opts.tol * r0) {
+      this->cycle(0, this->opts.cycle);
+      this->residual(0);
+      this->res = norm(fine.r);
+      ++it;
+    }
+
+    copy_out(fine.u, u);
+    return it;
+  }
+
+private:
+  template <typename V>
+  static void copy_in(const Tensor<T, N> &t, V &v) {
+    const auto &s = t.shape();
+#pragma omp parallel for
+    for (std::size_t i = 0; i < s[0]; ++i) {
+      if constexpr (N == 2) {
+        for (std::size_t j = 0; j < s[1]; ++j) {
+          v[i * s[1] + j] = t[i][j];
+        }
+      } else {
+        for (std::size_t j = 0; j < s[1]; ++j) {
+          for (std::size_t k = 0; k < s[2]; ++k) {
+            v[(i * s[1] + j) * s[2] + k] = t[i][j][k];
+          }
+        }
+      }
+    }
+  }
+
+  template <typename V>
+  static void copy_out(const V &v, Tensor<T, N> &t) {
+    const auto &s = t.shape();
+#pragma omp parallel for
+    for (std::size_t i = 0; i < s[0]; ++i) {
+      if constexpr (N == 2) {
+        for (std::size_t j = 0; j < s[1]; ++j) {
+          t[i][j] = v[i * s[1] + j];
+        }
+      } else {
+        for (std::size_t j = 0; j < s[1]; ++j) {
+          for (std::size_t k = 0; k < s[2]; ++k) {
+            t[i][j][k] = v[(i * s[1] + j) * s[2] + k];
+          }
+        }
+      }
+    }
+  }
+
+  static T norm(const std::vector<T> &v) {
+    T sum = T{0};
+#pragma omp parallel for reduction(+ : sum)
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      sum += v[i] * v[i];
+    }
+    return std::sqrt(sum);
+  }
+
+  /*
+   * Call `k(base, nb, parity)` for every row along the last axis in parallel, where `base` is the
+   * flat offset of the row, `nb` the offsets of its neighbouring rows (-1 for ghosts) and
+   * `parity` the parity of the row coordinates. Rows are visited serially unless `parallel`.
+   */
+  template <typename K>
+  static void rows(const Level &lv, K &&k, const bool parallel = true) {
+    const auto &dims = lv.dims;
+    const std::size_t nx = dims[N - 1];
+    std::size_t n_rows = 1;
+    for (std::size_t d = 0; d + 1 < N; ++d) {
+      n_rows *= dims[d];
+    }
+#pragma omp parallel for if (parallel)
+    for (std::size_t r = 0; r < n_rows; ++r) {
+      std::array<int64_t, N - 1> c;
+      std::size_t q = r;
+      int64_t parity = 0;
+      for (std::size_t d = N - 1; d-- > 0;) {
+        c[d] = q % dims[d];
+        q /= dims[d];
+        parity += c[d];
+      }
+      RowOffsets nb;
+      for (std::size_t d = 0; d + 1 < N; ++d) {
+        for (int64_t o = 0; o < 2; ++o) {
+          auto cc = c;
+          cc[d] = index(c[d] + 2 * o - 1, dims[d], lv.ghosts);
+          int64_t off = 0;
+          for (std::size_t e = 0; e + 1 < N && cc[d] >= 0; ++e) {
+            off = off * dims[e] + cc[e];
+          }
+          nb[2 * d + o] = cc[d] < 0 ? -1 : off * static_cast<int64_t>(nx);
+        }
+      }
+      k(static_cast<int64_t>(r * nx), nb, parity & 1);
+    }
+  }
+
+  /* Index `i` of an axis of length `n` on a level, -1 for ghosts */
+  static inline int64_t index(const int64_t i, const int64_t n, const bool ghosts) {
+    return (ghosts && (i < 0 || i >= n)) ? -1 : border_index<BT>(i, n);
+  }
+
+  /*
+   * Sum of the neighbours of point j of a row, without the adjacent-value part of the ghosts;
+   * counts the ghosts
+   */
+  static inline T neighbours(const Level &lv, const T *u, const int64_t base, const RowOffsets &nb,
+                             const int64_t j, int64_t &n_ghost) {
+    const int64_t nx = lv.dims[N - 1];
+    T s = T{0};
+    n_ghost = 0;
+    for (std::size_t m = 0; m < nb.size(); ++m) {
+      if (nb[m] >= 0) {
+        s += u[nb[m] + j];
+        continue;
+      }
+      // The opposite neighbour is on the grid unless the axis has a single point
+      const int64_t o = nb[m ^ 1];
+      s += lv.g + (o < 0 ? T{0} : lv.gm * u[o + j]);
+      ++n_ghost;
+    }
+    if (j > 0 && j < nx - 1) {
+      return s + u[base + j - 1] + u[base + j + 1];
+    }
+    const int64_t jm = index(j - 1, nx, lv.ghosts);
+    const int64_t jp = index(j + 1, nx, lv.ghosts);
+    n_ghost += (jm < 0) + (jp < 0);
+    const auto ghost = [&](const int64_t o) { return lv.g + (o < 0 ? T{0} : lv.gm * u[base + o]); };
+    return s + (jm < 0 ? ghost(jp) : u[base + jm]) + (jp < 0 ? ghost(jm) : u[base + jp]);
+  }
+
+  void residual(const std::size_t l) {
+    auto &lv = this->levels[l];
+    const int64_t nx = lv.dims[N - 1];
+    const T off = this->beta * lv.h2inv;
+    const T diag = this->alpha + T{2 * N} * off;
+    const T *u = lv.u.data();
+    rows(lv, [&](const int64_t base, const RowOffsets &nb, int64_t) {
+      for (int64_t j = 0; j < nx; ++j) {
+        int64_t k;
+        const T sum = neighbours(lv, u, base, nb, j, k);
+        const T au = (diag - off * lv.gs * k) * u[base + j] - off * sum;
+        lv.r[base + j] = lv.f[base + j] - au;
+      }
+    });
+  }
+
+  void smooth(const std::size_t l, const std::size_t sweeps) {
+    auto &lv = this->levels[l];
+    const int64_t nx = lv.dims[N - 1];
+    const T off = this->beta * lv.h2inv;
+    const T diag = this->alpha + T{2 * N} * off;
+    for (std::size_t s = 0; s < sweeps; ++s) {
+      if (this->opts.smoother == SmootherType::RED_BLACK_GAUSS_SEIDEL) {
+        // With WRAP, an odd extent makes the first and last rows of that axis periodic neighbours
+        // of the same colour, so they must not be updated concurrently
+        bool parallel = true;
+        for (std::size_t d = 0; d + 1 < N; ++d) {
+          parallel = parallel && (BT != BorderType::WRAP || lv.dims[d] % 2 == 0);
+        }
+        for (int64_t color = 0; color < 2; ++color) {
+          T *u = lv.u.data();
+          rows(lv, [&](const int64_t base, const RowOffsets &nb, const int64_t parity) {
+            for (int64_t j = (color + parity) & 1; j < nx; j += 2) {
+              int64_t k;
+              const T sum = neighbours(lv, u, base, nb, j, k);
+              u[base + j] = (lv.f[base + j] + off * sum) / (diag - off * lv.gs * k);
+            }
+          }, parallel);
+        }
+      } else {
+        // Damped Jacobi; the residual buffer holds the previous iterate
+        lv.r = lv.u;
+        const T *u = lv.r.data();
+        const T omega = this->opts.omega;
+        rows(lv, [&](const int64_t base, const RowOffsets &nb, int64_t) {
+          for (int64_t j = 0; j < nx; ++j) {
+            int64_t k;
+            const T sum = neighbours(lv, u, base, nb, j, k);
+            const T next = (lv.f[base + j] + off * sum) / (diag - off * lv.gs * k);
+            lv.u[base + j] = (T{1} - omega) * u[base + j] + omega * next;
+          }
+        });
+      }
+    }
+  }
+
+  /* Average the residual of the 2^N children into the right-hand side of level l + 1 */
+  void restriction(const std::size_t l) {
+    const auto &fine = this->levels[l];
+    auto &coarse = this->levels[l + 1];
+    const int64_t nx = coarse.dims[N - 1];
+    const int64_t fx = fine.dims[N - 1];
+    const int64_t fy = fine.dims[N - 2];
+    const T scale = T{1} / T{1 << N};
+    rows(coarse, [&](const int64_t base, const RowOffsets &, int64_t) {
+      // Fine rows below the coarse row: 2 in 2D, 4 in 3D
+      const int64_t r = base / nx;
+      std::array<int64_t, 1 << (N - 1)> fr;
+      if constexpr (N == 2) {
+        fr = {2 * r * fx, (2 * r + 1) * fx};
+      } else {
+        const int64_t ci = r / coarse.dims[1], cj = r % coarse.dims[1];
+        for (int64_t a = 0; a < 2; ++a) {
+          for (int64_t b = 0; b < 2; ++b) {
+            fr[2 * a + b] = ((2 * ci + a) * fy + (2 * cj + b)) * fx;
+          }
+        }
+      }
+      for (int64_t j = 0; j < nx; ++j) {
+        T s = T{0};
+        for (const auto o : fr) {
+          s += fine.r[o + 2 * j] + fine.r[o + 2 * j + 1];
+        }
+        coarse.f[base + j] = s * scale;
+        coarse.u[base + j] = T{0};
+      }
+    });
+  }
+
+  /* Add the (bi/tri)linearly interpolated correction of level l + 1 to level l */
+  void prolongation(const std::size_t l) {
+    auto &fine = this->levels[l];
+    const auto &coarse = this->levels[l + 1];
+    const auto &cd = coarse.dims;
+    const int64_t nx = fine.dims[N - 1];
+    const int64_t cx = cd[N - 1];
+    rows(fine, [&](const int64_t base, const RowOffsets &, int64_t) {
+      // Coarse rows contributing to this fine row with their weights
+      const int64_t r = base / nx;
+      std::array<int64_t, N - 1> c;
+      if constexpr (N == 2) {
+        c = {r};
+      } else {
+        const int64_t fy = fine.dims[1];
+        c = {r / fy, r % fy};
+      }
+      std::array<int64_t, 1 << (N - 1)> cr;
+      std::array<T, 1 << (N - 1)> cw;
+      for (std::size_t m = 0; m < cr.size(); ++m) {
+        int64_t off = 0;
+        T w = T{1};
+        for (std::size_t d = 0; d + 1 < N; ++d) {
+          const int64_t ic = c[d] / 2;
+          const int64_t step = (c[d] & 1) ? 1 : -1;
+          const int64_t ix = index(ic + step, cd[d], coarse.ghosts);
+          // A ghost row is the adjacent row and the row opposite it, weighted as in neighbours
+          if (((m >> d) & 1) == 0) {
+            w *= ix < 0 ? T{0.75} + T{0.25} * coarse.gs : T{0.75};
+            off = off * cd[d] + ic;
+          } else {
+            const int64_t io = index(ic - step, cd[d], coarse.ghosts);
+            w *= ix < 0 ? (io < 0 ? T{0} : T{0.25} * coarse.gm) : T{0.25};
+            off = off * cd[d] + (ix < 0 ? (io < 0 ? ic : io) : ix);
+          }
+        }
+        cr[m] = off * cx;
+        cw[m] = w;
+      }
+      for (int64_t j = 0; j < nx; ++j) {
+        const int64_t jc = j / 2;
+        const int64_t step = (j & 1) ? 1 : -1;
+        const int64_t jn = index(jc + step, cx, coarse.ghosts);
+        const int64_t jo = index(jc - step, cx, coarse.ghosts);
+        T s = T{0};
+        for (std::size_t m = 0; m < cr.size(); ++m) {
+          const T *u = coarse.u.data() + cr[m];
+          const T far = jn < 0 ? coarse.gs * u[jc] + (jo < 0 ? T{0} : coarse.gm * u[jo]) : u[jn];
+          s += cw[m] * (T{0.75} * u[jc] + T{0.25} * far);
+        }
+        fine.u[base + j] += s;
+      }
+    });
+  }
+
+  void cycle(const std::size_t l, const CycleType type) {
+    if (l + 1 == this->levels.size()) {
+      this->smooth(l, this->opts.coarse);
+      return;
+    }
+    this->smooth(l, this->opts.pre);
+    this->residual(l);
+    this->restriction(l);
+    switch (type) {
+    case CycleType::V:
+      this->cycle(l + 1, CycleType::V);
+      break;
+    case CycleType::W:
+      this->cycle(l + 1, CycleType::W);
+      this->cycle(l + 1, CycleType::W);
+      break;
+    case CycleType::F:
+      this->cycle(l + 1, CycleType::F);
+      this->cycle(l + 1, CycleType::V);
+      break;
+    }
+    this->prolongation(l);
+    this->smooth(l, this->opts.post);
+  }
+};
+} // namespace libtensor
+#endif
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LIBTENSOR__IMPL__STENCIL__
+#define __LIBTENSOR__IMPL__STENCIL__
+
+#include "filter.hh"
+#include "libtensor.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace libtensor {
+/*
+ * Apply `steps` iterations of a 3x3 stencil followed by a point-wise update,
+ *   u_{k+1} = f(u_k, conv(u_k, filter))   with   f(T &ret, const T &u, const T &conv),
+ * using overlapped temporal tiling. Each tile is loaded once together with a halo of `steps`
+ * points, advanced `steps` times in a cache-resident buffer and written back, so the grid is
+ * streamed from memory once instead of once per step. The result equals calling conv2d and map
+ * `steps` times. `tensor` and `ret` may be the same object.
+ */
+template <typename T, BorderType BT = BorderType::REFLECT, typename F>
+void stencil2d(const Tensor<T, 2> &tensor, const Tensor<T, 2> &filter, Tensor<T, 2> &ret, F &&f,
+               const std::size_t steps, const std::size_t tile = 64,
+               [[maybe_unused]] T cst = T{}) {
+  const auto &t_shape = tensor.shape();
+  if (filter.shape() != Shape<2>({3, 3})) {
+    throw std::invalid_argument("invalid shape of kernel given");
+  }
+  if (ret.shape() != t_shape) {
+    throw std::invalid_argument("shape result does not match between give & result");
+  }
+  if (tile == 0) {
+    throw std::invalid_argument("invalid tile size");
+  }
+  if constexpr (BT == BorderType::INTERNAL || BT == BorderType::WRAP) {
+    // WRAP needs halo data from the opposite side of the domain, which a tile does not hold
+    throw std::invalid_argument("Not supported yet");
+  }
+
+  const int64_t ny = t_shape[0];
+  const int64_t nx = t_shape[1];
+  const int64_t h = steps;
+  const int64_t b = tile;
+  const int64_t ty = (ny + b - 1) / b;
+  const int64_t tx = (nx + b - 1) / b;
+  T w[3][3];
+  for (std::size_t m = 0; m < 3; ++m) {
+    for (std::size_t n = 0; n < 3; ++n) {
+      w[m][n] = filter[m][n];
+    }
+  }
+
+  // In-place results are staged per tile so that every tile reads only the original field
+  const bool in_place = (&tensor == &ret);
+  std::vector<std::vector<T>> staged(in_place ? ty * tx : 0);
+
+#pragma omp parallel
+  {
+    std::vector<T> cur, next;
+#pragma omp for collapse(2) schedule(static)
+    for (int64_t by = 0; by < ty; ++by) {
+      for (int64_t bx = 0; bx < tx; ++bx) {
+        // Tile [y0, y1) x [x0, x1) and buffer window [wy0, wy1) x [wx0, wx1) clipped to the grid
+        const int64_t y0 = by * b, y1 = std::min(y0 + b, ny);
+        const int64_t x0 = bx * b, x1 = std::min(x0 + b, nx);
+        const int64_t wy0 = std::max<int64_t>(y0 - h, 0), wy1 = std::min(y1 + h, ny);
+        const int64_t wx0 = std::max<int64_t>(x0 - h, 0), wx1 = std::min(x1 + h, nx);
+        const int64_t ld = wx1 - wx0;
+        cur.resize((wy1 - wy0) * ld);
+        next.resize(cur.size());
+        for (int64_t i = wy0; i < wy1; ++i) {
+          const auto &row = tensor[i];
+          for (int64_t j = wx0; j < wx1; ++j) {
+            cur[(i - wy0) * ld + (j - wx0)] = row[j];
+          }
+        }
+
+        for (int64_t s = 1; s <= h; ++s) {
+          // Points still exact after step s shrink by one per step from the buffer window
+          const int64_t sy0 = std::max(y0 - (h - s), wy0), sy1 = std::min(y1 + (h - s), wy1);
+          const int64_t sx0 = std::max(x0 - (h - s), wx0), sx1 = std::min(x1 + (h - s), wx1);
+          for (int64_t i = sy0; i < sy1; ++i) {
+            const bool y_edge = (i == 0 || i == ny - 1);
+            // Points whose neighbours need the border rule
+            const auto border = [&](const int64_t j) {
+              T acc = T{0};
+              for (int64_t m = 0; m < 3; ++m) {
+                const int64_t y = border_index<BT>(i + m - 1, ny);
+                for (int64_t n = 0; n < 3; ++n) {
+                  const int64_t x = border_index<BT>(j + n - 1, nx);
+                  acc += ((y < 0 || x < 0) ? cst : cur[(y - wy0) * ld + (x - wx0)]) * w[m][n];
+                }
+              }
+              const auto idx = (i - wy0) * ld + (j - wx0);
+              f(next[idx], cur[idx], acc);
+            };
+            if (y_edge) {
+              for (int64_t j = sx0; j < sx1; ++j) {
+                border(j);
+              }
+              continue;
+            }
+            const int64_t jb = std::max<int64_t>(sx0, 1), je = std::min(sx1, nx - 1);
+            if (sx0 < jb) {
+              border(sx0);
+            }
+            const T *up = cur.data() + (i - 1 - wy0) * ld;
+            const T *mid = cur.data() + (i - wy0) * ld;
+            const T *dn = cur.data() + (i + 1 - wy0) * ld;
+            T *out = next.data() + (i - wy0) * ld;
+#pragma omp simd
+            for (int64_t j = jb - wx0; j < je - wx0; ++j) {
+              const T acc = w[0][0] * up[j - 1] + w[0][1] * up[j] + w[0][2] * up[j + 1] +
+                            w[1][0] * mid[j - 1] + w[1][1] * mid[j] + w[1][2] * mid[j + 1] +
+                            w[2][0] * dn[j - 1] + w[2][1] * dn[j] + w[2][2] * dn[j + 1];
+              f(out[j], mid[j], acc);
+            }
+            if (je < sx1) {
+              border(je);
+            }
+          }
+          std::swap(cur, next);
+        }
+
+        if (!in_place) {
+          for (int64_t i = y0; i < y1; ++i) {
+            auto &row = ret[i];
+            for (int64_t j = x0; j < x1; ++j) {
+              row[j] = cur[(i - wy0) * ld + (j - wx0)];
+            }
+          }
+          continue;
+        }
+        auto &out = staged[by * tx + bx];
+        out.resize((y1 - y0) * (x1 - x0));
+        for (int64_t i = y0; i < y1; ++i) {
+          const auto src = cur.begin() + (i - wy0) * ld + (x0 - wx0);
+          std::copy(src, src + (x1 - x0), out.begin() + (i - y0) * (x1 - x0));
+        }
+      }
+    }
+
+    if (in_place) {
+#pragma omp for collapse(2) schedule(static)
+      for (int64_t by = 0; by < ty; ++by) {
+        for (int64_t bx = 0; bx < tx; ++bx) {
+          const int64_t y0 = by * b, y1 = std::min(y0 + b, ny);
+          const int64_t x0 = bx * b, x1 = std::min(x0 + b, nx);
+          const auto &in = staged[by * tx + bx];
+          for (int64_t i = y0; i < y1; ++i) {
+            auto &row = ret[i];
+            for (int64_t j = x0; j < x1; ++j) {
+              row[j] = in[(i - y0) * (x1 - x0) + (j - x0)];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+} // namespace libtensor
+#endif
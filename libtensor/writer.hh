@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LIBTENSOR__IMPL__WRITER__
+#define __LIBTENSOR__IMPL__WRITER__
+
+#include "libtensor.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace libtensor {
+/*
+ * Streaming writers of 2D/3D grids for visualisation (ParaView, VisIt).
+ *
+ *   VTKWriter:  VTK XML image data (.vti) with inline base64 data
+ *   XDMFWriter: raw binary data plus an XDMF (.xmf) descriptor referencing it
+ *
+ * Fields are written one at a time as soon as `write` is called, in chunks of about `chunk` bytes
+ * that are gathered and encoded in parallel, so memory use does not depend on the grid size.
+ * With `stride` > 1 every stride-th point along each axis is written and the spacing is scaled
+ * accordingly. The last tensor axis is the x axis of the output.
+ */
+namespace output {
+template <typename T>
+struct Type;
+template <>
+struct Type<float> {
+  static constexpr const char *vtk = "Float32", *xdmf = "Float";
+};
+template <>
+struct Type<double> {
+  static constexpr const char *vtk = "Float64", *xdmf = "Float";
+};
+template <>
+struct Type<std::int8_t> {
+  static constexpr const char *vtk = "Int8", *xdmf = "Char";
+};
+template <>
+struct Type<std::uint8_t> {
+  static constexpr const char *vtk = "UInt8", *xdmf = "UChar";
+};
+template <>
+struct Type<std::int32_t> {
+  static constexpr const char *vtk = "Int32", *xdmf = "Int";
+};
+template <>
+struct Type<std::uint32_t> {
+  static constexpr const char *vtk = "UInt32", *xdmf = "UInt";
+};
+template <>
+struct Type<std::int64_t> {
+  static constexpr const char *vtk = "Int64", *xdmf = "Int";
+};
+template <>
+struct Type<std::uint64_t> {
+  static constexpr const char *vtk = "UInt64", *xdmf = "UInt";
+};
+
+inline constexpr char base64_chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/* Base64 of n bytes into 4 * ceil(n / 3) characters; only the last block may be padded */
+inline void base64(const std::uint8_t *in, const std::size_t n, char *out) {
+  std::size_t i = 0;
+  for (; i + 3 <= n; i += 3, out += 4) {
+    const std::uint32_t v = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+    out[0] = base64_chars[(v >> 18) & 0x3f];
+    out[1] = base64_chars[(v >> 12) & 0x3f];
+    out[2] = base64_chars[(v >> 6) & 0x3f];
+    out[3] = base64_chars[v & 0x3f];
+  }
+  if (i < n) {
+    const std::uint32_t v = (in[i] << 16) | ((i + 1 < n ? in[i + 1] : 0) << 8);
+    out[0] = base64_chars[(v >> 18) & 0x3f];
+    out[1] = base64_chars[(v >> 12) & 0x3f];
+    out[2] = i + 1 < n ? base64_chars[(v >> 6) & 0x3f] : '=';
+    out[3] = '=';
+  }
+}
+
+inline std::string number(const double v) {
+  std::ostringstream os;
+  os.precision(15);
+  os << v;
+  return os.str();
+}
+
+inline bool little_endian() {
+  const std::uint16_t one = 1;
+  std::uint8_t b;
+  std::memcpy(&b, &one, 1);
+  return b == 1;
+}
+
+inline void check_name(const std::string &name) {
+  if (name.empty() || name.find_first_of("<>&\"' ") != std::string::npos) {
+    throw std::invalid_argument("invalid field name");
+  }
+}
+
+/* Grid shape after keeping every stride-th point */
+template <std::size_t N>
+Shape<N> sampled(const Shape<N> &s, const std::size_t stride) {
+  Shape<N> ret;
+  for (std::size_t d = 0; d < N; ++d) {
+    ret[d] = (s[d] + stride - 1) / stride;
+  }
+  return ret;
+}
+
+/* Innermost row `r` of the sampled grid, counting rows in row-major order */
+template <typename U, std::size_t N>
+const Tensor<U, 1> &row(const Tensor<U, N> &t, [[maybe_unused]] const Shape<N> &out,
+                        const std::size_t stride, const std::size_t r) {
+  if constexpr (N == 2) {
+    return t[r * stride];
+  } else {
+    return t[(r / out[1]) * stride][(r % out[1]) * stride];
+  }
+}
+
+/*
+ * Gather the sampled grid in chunks of whole rows and pass the bytes of each chunk to `sink`.
+ * `fetch(r, dst)` writes the `width` values of row r to dst.
+ */
+template <typename T, std::size_t N, typename Fetch, typename Sink>
+void stream_rows(const Shape<N> &out, const std::size_t width, const std::size_t chunk,
+                 Fetch &&fetch, Sink &&sink) {
+  std::size_t rows = 1;
+  for (std::size_t d = 0; d + 1 < N; ++d) {
+    rows *= out[d];
+  }
+  // An empty grid has no bytes to write
+  if (rows == 0 || width == 0) {
+    return;
+  }
+  const std::size_t per_chunk = std::max<std::size_t>(1, chunk / (width * sizeof(T)));
+  std::vector<T> buffer(std::min(per_chunk, rows) * width);
+  for (std::size_t r0 = 0; r0 < rows; r0 += per_chunk) {
+    const std::size_t r1 = std::min(r0 + per_chunk, rows);
+#pragma omp parallel for
+    for (std::size_t r = r0; r < r1; ++r) {
+      fetch(r, buffer.data() + (r - r0) * width);
+    }
+    sink(reinterpret_cast<const std::uint8_t *>(buffer.data()), (r1 - r0) * width * sizeof(T));
+  }
+}
+
+/* Write every stride-th point of `t` (M components of a FieldSet, or 1 for a Tensor) */
+template <typename T, std::size_t N, typename Sink>
+void stream(const Tensor<T, N> &t, const std::size_t stride, const std::size_t chunk,
+            Sink &&sink) {
+  const auto out = sampled(t.shape(), stride);
+  const std::size_t w = out[N - 1];
+  stream_rows<T, N>(out, w, chunk, [&](const std::size_t r, T *dst) {
+    const auto &src = row(t, out, stride, r);
+    for (std::size_t x = 0; x < w; ++x) {
+      dst[x] = src[x * stride];
+    }
+  }, std::forward<Sink>(sink));
+}
+
+template <typename T, std::size_t M, std::size_t N, Layout L, typename Sink>
+void stream(const FieldSet<T, M, N, L> &fs, const std::size_t stride, const std::size_t chunk,
+            Sink &&sink) {
+  const auto out = sampled(fs.shape(), stride);
+  const std::size_t w = out[N - 1];
+  stream_rows<T, N>(out, w * M, chunk, [&](const std::size_t r, T *dst) {
+    if constexpr (L == Layout::SOA) {
+      for (std::size_t k = 0; k < M; ++k) {
+        const auto &src = row(fs.data()[k], out, stride, r);
+        for (std::size_t x = 0; x < w; ++x) {
+          dst[x * M + k] = src[x * stride];
+        }
+      }
+    } else {
+      const auto &src = row(fs.data(), out, stride, r);
+      for (std::size_t x = 0; x < w; ++x) {
+        std::copy(src[x * stride].begin(), src[x * stride].end(), dst + x * M);
+      }
+    }
+  }, std::forward<Sink>(sink));
+}
+} // namespace output
+
+template <std::size_t N>
+class VTKWriter {
+  static_assert(N == 2 || N == 3, "VTKWriter supports 2D and 3D grids");
+
+public:
+  using Shape = libtensor::Shape<N>;
+
+private:
+  static constexpr std::size_t group = 3 * 1024;
+
+  std::ostream &os;
+  Shape dims;
+  std::size_t stride;
+  std::size_t chunk;
+  bool open = true;
+
+public:
+  VTKWriter(std::ostream &s, const Shape &shape, const std::size_t stride = 1,
+            const double spacing = 1.0, const std::size_t chunk = std::size_t{1} << 20)
+      : os(s), dims(shape), stride(stride), chunk(chunk) {
+    if (stride == 0) {
+      throw std::invalid_argument("invalid stride");
+    }
+    const auto out = output::sampled(shape, stride);
+    std::string extent;
+    for (std::size_t a = 0; a < 3; ++a) {
+      // Axis a of the image is tensor axis N - 1 - a
+      const std::size_t n = a < N ? out[N - 1 - a] : 1;
+      extent += (extent.empty() ? "0 " : " 0 ") + std::to_string(n > 0 ? n - 1 : 0);
+    }
+    const auto h = output::number(spacing * stride);
+    this->os << "<?xml version=\"1.0\"?>\n"
+             << "<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\""
+             << (output::little_endian() ? "LittleEndian" : "BigEndian")
+             << "\" header_type=\"UInt64\">\n"
+             << "<ImageData WholeExtent=\"" << extent << "\" Origin=\"0 0 0\" Spacing=\"" << h
+             << " " << h << " " << (N == 3 ? h : output::number(spacing)) << "\">\n"
+             << "<Piece Extent=\"" << extent << "\">\n"
+             << "<PointData>\n";
+  }
+
+  VTKWriter(const VTKWriter &) = delete;
+  VTKWriter &operator=(const VTKWriter &) = delete;
+
+  ~VTKWriter() {
+    if (this->open) {
+      try {
+        this->close();
+      } catch (...) {
+      }
+    }
+  }
+
+  template <typename T>
+  VTKWriter &write(const std::string &name, const Tensor<T, N> &t) {
+    this->write_array<T>(name, t, 1);
+    return *this;
+  }
+
+  /* The components of a FieldSet are written as one array with M components per point */
+  template <typename T, std::size_t M, Layout L>
+  VTKWriter &write(const std::string &name, const FieldSet<T, M, N, L> &fs) {
+    this->write_array<T>(name, fs, M);
+    return *this;
+  }
+
+  void close() {
+    if (!this->open) {
+      return;
+    }
+    this->open = false;
+    this->os << "</PointData>\n</Piece>\n</ImageData>\n</VTKFile>\n";
+    this->os.flush();
+    if (!this->os) {
+      throw std::runtime_error("failed to write VTK stream");
+    }
+  }
+
+private:
+  /* Header and data are encoded as separate base64 blocks, as VTK writes them */
+  template <typename T, typename Source>
+  void write_array(const std::string &name, const Source &src, const std::size_t comps) {
+    output::check_name(name);
+    if (!this->open) {
+      throw std::runtime_error("writer is closed");
+    }
+    if (src.shape() != this->dims) {
+      throw std::invalid_argument("invalid dimensions");
+    }
+    const auto out = output::sampled(this->dims, this->stride);
+    std::uint64_t bytes = comps * sizeof(T);
+    for (const auto d : out) {
+      bytes *= d;
+    }
+    this->os << "<DataArray type=\"" << output::Type<T>::vtk << "\" Name=\"" << name
+             << "\" NumberOfComponents=\"" << comps << "\" format=\"binary\">\n";
+    char header[12];
+    output::base64(reinterpret_cast<const std::uint8_t *>(&bytes), sizeof(bytes), header);
+    this->os.write(header, sizeof(header));
+
+    // Bytes left over from the previous chunk, so that every chunk is encoded in whole groups
+    std::vector<std::uint8_t> pending;
+    std::vector<char> encoded;
+    output::stream(src, this->stride, this->chunk, [&](const std::uint8_t *p, std::size_t n) {
+      pending.insert(pending.end(), p, p + n);
+      const std::size_t ready = pending.size() / 3 * 3;
+      encoded.resize(ready / 3 * 4);
+      const std::size_t n_groups = (ready + group - 1) / group;
+#pragma omp parallel for
+      for (std::size_t g = 0; g < n_groups; ++g) {
+        const std::size_t begin = g * group;
+        const std::size_t len = std::min(begin + group, ready) - begin;
+        output::base64(pending.data() + begin, len, encoded.data() + begin / 3 * 4);
+      }
+      this->os.write(encoded.data(), encoded.size());
+      pending.erase(pending.begin(), pending.begin() + ready);
+    });
+    char tail[4];
+    if (!pending.empty()) {
+      output::base64(pending.data(), pending.size(), tail);
+      this->os.write(tail, sizeof(tail));
+    }
+    this->os << "\n</DataArray>\n";
+    if (!this->os) {
+      throw std::runtime_error("failed to write VTK stream");
+    }
+  }
+};
+
+template <std::size_t N>
+class XDMFWriter {
+  static_assert(N == 2 || N == 3, "XDMFWriter supports 2D and 3D grids");
+
+public:
+  using Shape = libtensor::Shape<N>;
+
+private:
+  struct Entry {
+    std::string name;
+    const char *type;
+    std::size_t precision;
+    std::size_t comps;
+    std::uint64_t offset;
+  };
+
+  std::ostream &xml;
+  std::ostream &bin;
+  std::string bin_name;
+  Shape dims;
+  std::size_t stride;
+  double spacing;
+  std::size_t chunk;
+  std::uint64_t offset = 0;
+  std::vector<Entry> entries;
+  bool open = true;
+
+public:
+  /* `bin_name` is the path of `bin` as referenced from the descriptor */
+  XDMFWriter(std::ostream &xml, std::ostream &bin, const std::string &bin_name,
+             const Shape &shape, const std::size_t stride = 1, const double spacing = 1.0,
+             const std::size_t chunk = std::size_t{1} << 20)
+      : xml(xml), bin(bin), bin_name(bin_name), dims(shape), stride(stride), spacing(spacing),
+        chunk(chunk) {
+    if (stride == 0) {
+      throw std::invalid_argument("invalid stride");
+    }
+  }
+
+  XDMFWriter(const XDMFWriter &) = delete;
+  XDMFWriter &operator=(const XDMFWriter &) = delete;
+
+  ~XDMFWriter() {
+    if (this->open) {
+      try {
+        this->close();
+      } catch (...) {
+      }
+    }
+  }
+
+  template <typename T>
+  XDMFWriter &write(const std::string &name, const Tensor<T, N> &t) {
+    this->write_array<T>(name, t, 1);
+    return *this;
+  }
+
+  template <typename T, std::size_t M, Layout L>
+  XDMFWriter &write(const std::string &name, const FieldSet<T, M, N, L> &fs) {
+    this->write_array<T>(name, fs, M);
+    return *this;
+  }
+
+  /* Write the descriptor; the binary data has already been streamed by `write` */
+  void close() {
+    if (!this->open) {
+      return;
+    }
+    this->open = false;
+    const auto out = output::sampled(this->dims, this->stride);
+    std::string dims, origin, step;
+    for (std::size_t d = 0; d < N; ++d) {
+      dims += (d ? " " : "") + std::to_string(out[d]);
+      origin += d ? " 0" : "0";
+      step += (d ? " " : "") + output::number(this->spacing * this->stride);
+    }
+    const char *geometry = (N == 3) ? "ORIGIN_DXDYDZ" : "ORIGIN_DXDY";
+    this->xml << "<?xml version=\"1.0\"?>\n"
+              << "<Xdmf Version=\"3.0\">\n<Domain>\n<Grid Name=\"grid\" GridType=\"Uniform\">\n"
+              << "<Topology TopologyType=\"" << N << "DCoRectMesh\" Dimensions=\"" << dims
+              << "\"/>\n"
+              << "<Geometry GeometryType=\"" << geometry << "\">\n"
+              << "<DataItem Format=\"XML\" Dimensions=\"" << N << "\">" << origin
+              << "</DataItem>\n"
+              << "<DataItem Format=\"XML\" Dimensions=\"" << N << "\">" << step
+              << "</DataItem>\n"
+              << "</Geometry>\n";
+    for (const auto &e : this->entries) {
+      const char *kind = e.comps == 1 ? "Scalar" : (e.comps == 3 ? "Vector" : "Matrix");
+      this->xml << "<Attribute Name=\"" << e.name << "\" AttributeType=\"" << kind
+                << "\" Center=\"Node\">\n"
+                << "<DataItem Format=\"Binary\" NumberType=\"" << e.type << "\" Precision=\""
+                << e.precision << "\" Endian=\"Native\" Seek=\"" << e.offset
+                << "\" Dimensions=\"" << dims;
+      if (e.comps > 1) {
+        this->xml << " " << e.comps;
+      }
+      this->xml << "\">" << this->bin_name << "</DataItem>\n</Attribute>\n";
+    }
+    this->xml << "</Grid>\n</Domain>\n</Xdmf>\n";
+    this->xml.flush();
+    this->bin.flush();
+    if (!this->xml || !this->bin) {
+      throw std::runtime_error("failed to write XDMF stream");
+    }
+  }
+
+private:
+  template <typename T, typename Source>
+  void write_array(const std::string &name, const Source &src, const std::size_t comps) {
+    output::check_name(name);
+    if (!this->open) {
+      throw std::runtime_error("writer is closed");
+    }
+    if (src.shape() != this->dims) {
+      throw std::invalid_argument("invalid dimensions");
+    }
+    this->entries.push_back({name, output::Type<T>::xdmf, sizeof(T), comps, this->offset});
+    output::stream(src, this->stride, this->chunk, [&](const std::uint8_t *p, std::size_t n) {
+      this->bin.write(reinterpret_cast<const char *>(p), n);
+      this->offset += n;
+    });
+    if (!this->bin) {
+      throw std::runtime_error("failed to write XDMF stream");
+    }
+  }
+};
+} // namespace libtensor
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <libtensor/active.hh>
+#include <libtensor/filter.hh>
+#include <libtensor/libtensor.hh>
+
+using Tensor2D = libtensor::Tensor<double, 2>;
+using Tensor3D = libtensor::Tensor<double, 3>;
+using Mask2D = libtensor::ActiveMask<2>;
+using Mask3D = libtensor::ActiveMask<3>;
+
+// Disc of radius 10 with a diffuse interface in a 64x64 domain
+Tensor2D get_disc() {
+  auto t = Tensor2D::fromShape({64, 64});
+  for (std::size_t i = 0; i < 64; ++i) {
+    for (std::size_t j = 0; j < 64; ++j) {
+      const double r = std::hypot(i - 32.0, j - 32.0);
+      t[i][j] = std::clamp(0.5 * (10.0 - r) + 0.5, 0.0, 1.0);
+    }
+  }
+  return t;
+}
+
+Tensor2D get_2d_filter() {
+  auto f = Tensor2D::fromShape({3, 3});
+  f[0][0] = 0.0, f[0][1] = 1.0, f[0][2] = 0.0;
+  f[1][0] = 1.0, f[1][1] = -4.0, f[1][2] = 1.0;
+  f[2][0] = 0.0, f[2][1] = 1.0, f[2][2] = 0.0;
+  return f;
+}
+
+TEST(active, rebuild) {
+  const auto t = get_disc();
+  Mask2D mask(t.shape(), 8);
+
+  ASSERT_EQ(mask.n_active(), 64u);
+  mask.rebuild(t);
+  ASSERT_GT(mask.n_active(), 0u);
+  ASSERT_LT(mask.n_active(), 64u);
+  ASSERT_FALSE(mask.active({0, 0}));
+  ASSERT_TRUE(mask.active({2, 4}));
+
+  // A sharp step between two saturated tiles still activates both sides
+  auto step = Tensor2D::fromShape({16, 16}).fill(0.0);
+  for (std::size_t i = 0; i < 16; ++i) {
+    for (std::size_t j = 8; j < 16; ++j) {
+      step[i][j] = 1.0;
+    }
+  }
+  Mask2D step_mask(step.shape(), 4);
+  step_mask.rebuild(step);
+  ASSERT_EQ(step_mask.n_active(), 8u);
+  ASSERT_TRUE(step_mask.active({0, 1}));
+  ASSERT_TRUE(step_mask.active({0, 2}));
+  ASSERT_FALSE(step_mask.active({0, 0}));
+
+  ASSERT_THROW(mask.rebuild(step), std::invalid_argument);
+}
+
+TEST(active, conv2d) {
+  const auto filter = get_2d_filter();
+  const auto t = get_disc();
+  Mask2D mask(t.shape(), 8);
+  mask.rebuild(t);
+
+  auto expect = Tensor2D::like(t);
+  libtensor::conv2d<double>(t, filter, expect);
+
+  // Inactive tiles of the full result are zero, because the field is saturated there
+  auto actual = Tensor2D::like(t).fill(0.0);
+  libtensor::conv2d_active<double>(mask, t, filter, actual);
+  ASSERT_EQ(expect, actual);
+
+  // Border handling at the domain edge follows conv2d
+  Mask2D full(t.shape(), 8);
+  const auto ones = Tensor2D::like(t).fill(1.0);
+  libtensor::conv2d_active<double>(full, ones, filter, actual);
+  ASSERT_EQ(Tensor2D::like(t).fill(0.0), actual);
+}
+
+TEST(active, conv2d_diagonal) {
+  // The corner weights of a 9-point kernel reach the diagonal tile (1, 1)
+  auto t = Tensor2D::fromShape({16, 16}).fill(0.0);
+  t[7][7] = 0.5;
+  const auto box = Tensor2D::fromShape({3, 3}).fill(1.0 / 9.0);
+  Mask2D mask(t.shape(), 8);
+  mask.rebuild(t);
+  ASSERT_TRUE(mask.active({1, 1}));
+
+  auto expect = Tensor2D::like(t);
+  libtensor::conv2d<double>(t, box, expect);
+  auto actual = Tensor2D::like(t).fill(0.0);
+  libtensor::conv2d_active<double>(mask, t, box, actual);
+  ASSERT_EQ(expect, actual);
+  ASSERT_GT(actual[8][8], 0.0);
+}
+
+TEST(active, update) {
+  const auto filter = get_2d_filter();
+  auto t = get_disc();
+  auto lap = Tensor2D::like(t).fill(0.0);
+  Mask2D mask(t.shape(), 8);
+  mask.rebuild(t);
+
+  const auto before = t;
+  for (int s = 0; s < 5; ++s) {
+    libtensor::conv2d_active<double>(mask, t, filter, lap);
+    libtensor::map_active(mask, t, [](double &v, const double l) { v += 0.1 * l; }, lap);
+    mask.update(t);
+
+    Mask2D expect(t.shape(), 8);
+    expect.rebuild(t);
+    ASSERT_EQ(expect.list(), mask.list());
+  }
+  ASSERT_NE(before, t);
+  ASSERT_EQ(before[0][0], t[0][0]);
+}
+
+TEST(active, map3d) {
+  auto t = Tensor3D::fromShape({8, 8, 8}).fill(0.0);
+  t[1][1][1] = 0.5;
+  Mask3D mask(t.shape(), 2);
+  mask.rebuild(t);
+  ASSERT_EQ(mask.n_active(), 8u);
+
+  libtensor::map_active(mask, t, [](double &v) { v += 1.0; });
+  ASSERT_EQ(t[0][0][0], 1.0);
+  ASSERT_EQ(t[1][1][1], 1.5);
+  ASSERT_EQ(t[2][0][0], 1.0);
+  ASSERT_EQ(t[3][3][3], 1.0);
+  ASSERT_EQ(t[4][0][0], 0.0);
+  ASSERT_EQ(t[7][7][7], 0.0);
+}
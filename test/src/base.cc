@@ -87,3 +87,68 @@ TEST(base, map) {
   ASSERT_THROW((t1.map_safe([](double &v1, const double v2) { v1 = v2; }, invalid_shape)),
                std::invalid_argument);
 }
+
+TEST(base, copy) {
+  auto t = Tensor3D::fromShape({2, 3, 4});
+  std::vector<double> flat(t.size());
+  ASSERT_EQ(flat.size(), 24u);
+  for (std::size_t i = 0; i < flat.size(); ++i) {
+    flat[i] = static_cast<double>(i);
+  }
+
+  t.copy_from(0, flat.size(), flat.data());
+  ASSERT_EQ(t[0][0][0], 0.0);
+  ASSERT_EQ(t[0][2][3], 11.0);
+  ASSERT_EQ(t[1][1][2], 18.0);
+
+  std::vector<double> part(10);
+  t.copy_to(5, 15, part.data());
+  ASSERT_EQ(part, std::vector<double>(flat.begin() + 5, flat.begin() + 15));
+}
+
+TEST(base, reserve) {
+  auto t = Tensor2D::fromShape({4, 8}).fill(1.0);
+  const auto *first = &t[0][0];
+  const auto *last = &t[3][0];
+
+  // Shrinking and regrowing keeps the storage
+  t.resize({2, 4});
+  ASSERT_THAT(t.shape(), testing::ElementsAre(2, 4));
+  ASSERT_THROW(t.at(2), std::out_of_range);
+  ASSERT_THROW(t.at(1).at(4), std::out_of_range);
+  t.resize({4, 8});
+  ASSERT_EQ(first, &t[0][0]);
+  ASSERT_EQ(last, &t[3][0]);
+
+  // Resizing within a reservation does not allocate
+  auto r = Tensor3D::fromShape({1, 1, 1});
+  r.reserve({3, 4, 5});
+  ASSERT_THAT(r.shape(), testing::ElementsAre(1, 1, 1));
+  const auto *p = &r[0][0][0];
+  r.resize({3, 4, 5}).fill(2.0);
+  ASSERT_EQ(p, &r[0][0][0]);
+  ASSERT_EQ(r, Tensor3D::fromShape({3, 4, 5}).fill(2.0));
+
+  t.resize({1, 2}).shrink_to_fit();
+  ASSERT_EQ(t, Tensor2D::fromShape({1, 2}).fill(1.0));
+
+  // Regrowing keeps the overlap and zeroes every newly exposed element, whatever the axis
+  auto g = Tensor2D::fromShape({2, 4}).fill(7.0);
+  g.resize({1, 2}).resize({2, 4});
+  auto regrown = Tensor2D::fromShape({2, 4}).fill(0.0);
+  regrown[0][0] = regrown[0][1] = 7.0;
+  ASSERT_EQ(g, regrown);
+  auto h = Tensor3D::fromShape({2, 2, 2}).fill(3.0);
+  h.resize({1, 1, 2}).resize({2, 2, 2});
+  auto expect = Tensor3D::fromShape({2, 2, 2}).fill(0.0);
+  expect[0][0][0] = expect[0][0][1] = 3.0;
+  ASSERT_EQ(h, expect);
+}
+
+TEST(base, move) {
+  auto t = Tensor2D::fromShape({2, 3}).fill(4.0);
+  const auto *p = &t[1][2];
+  const auto moved = Tensor2D(std::move(t));
+  ASSERT_EQ(p, &moved[1][2]);
+  ASSERT_EQ(moved, Tensor2D::fromShape({2, 3}).fill(4.0));
+}
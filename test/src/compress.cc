@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <libtensor/compress.hh>
+#include <libtensor/libtensor.hh>
+
+#include <cstring>
+#include <sstream>
+
+using Tensor2D = libtensor::Tensor<double, 2>;
+using Tensor3D = libtensor::Tensor<double, 3>;
+
+Tensor3D get_field() {
+  auto t = Tensor3D::fromShape({7, 30, 40});
+  for (std::size_t i = 0; i < 7; ++i) {
+    for (std::size_t j = 0; j < 30; ++j) {
+      for (std::size_t k = 0; k < 40; ++k) {
+        t[i][j][k] = std::clamp(0.5 + 0.1 * (j - 15.0) + 0.01 * i * k, 0.0, 1.0);
+      }
+    }
+  }
+  return t;
+}
+
+TEST(compress, roundtrip) {
+  const auto t = get_field();
+  std::stringstream ss;
+  libtensor::compress(ss, t, 1000);
+
+  const auto actual = libtensor::decompress<double, 3>(ss);
+  ASSERT_EQ(t, actual);
+  ASSERT_LT(ss.str().size(), t.size() * sizeof(double) / 2);
+
+  // Non-finite values and signed zeros survive bit-exactly
+  auto special = Tensor2D::fromShape({2, 3});
+  special[0][0] = -0.0, special[0][1] = std::numeric_limits<double>::infinity();
+  special[0][2] = std::numeric_limits<double>::denorm_min(), special[1][0] = 1e300;
+  special[1][1] = -1e-300, special[1][2] = 42.0;
+  std::stringstream ss2;
+  libtensor::compress(ss2, special, 4);
+  const auto actual2 = libtensor::decompress<double, 2>(ss2);
+  ASSERT_EQ(special, actual2);
+  ASSERT_TRUE(std::signbit(actual2[0][0]));
+}
+
+TEST(compress, random_access) {
+  const auto t = get_field();
+  std::stringstream ss;
+  libtensor::compress(ss, t, 512);
+
+  libtensor::CompressedReader<double, 3> reader(ss);
+  ASSERT_THAT(reader.shape(), testing::ElementsAre(7, 30, 40));
+  ASSERT_EQ(reader.n_blocks(), (t.size() + 511) / 512);
+
+  const auto slab = reader.read_slab(2, 5);
+  ASSERT_THAT(slab.shape(), testing::ElementsAre(3, 30, 40));
+  for (std::size_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(slab[i], t[i + 2]);
+  }
+
+  const auto values = reader.read_range(1000, 1100);
+  ASSERT_EQ(values.size(), 100u);
+  ASSERT_EQ(values[0], t[0][25][0]);
+  ASSERT_EQ(values[99], t[0][27][19]);
+
+  ASSERT_EQ(reader.read(), t);
+  ASSERT_THROW(reader.read_slab(5, 8), std::invalid_argument);
+}
+
+TEST(compress, invalid) {
+  const auto t = get_field();
+  std::stringstream ss;
+  libtensor::compress(ss, t);
+
+  ASSERT_THROW((libtensor::decompress<double, 2>(ss)), std::invalid_argument);
+  std::stringstream garbage("not a tensor");
+  ASSERT_THROW((libtensor::decompress<double, 3>(garbage)), std::runtime_error);
+  ASSERT_THROW(libtensor::compress(ss, t, 0), std::invalid_argument);
+
+  // Tampered headers: n_blocks follows magic, n_dims, sizeof(T), shape and block
+  std::stringstream valid;
+  libtensor::compress(valid, t, 1000);
+  const auto stream = valid.str();
+  const std::size_t n_blocks_at = 4 + 4 + 4 + 3 * 8 + 8;
+  const auto tamper = [&](const std::size_t pos, const std::uint64_t v) {
+    auto s = stream;
+    std::memcpy(s.data() + pos, &v, sizeof(v));
+    return std::stringstream(s);
+  };
+  const auto read = [&](const std::size_t pos, const std::uint64_t v) {
+    auto s = tamper(pos, v);
+    return libtensor::decompress<double, 3>(s);
+  };
+  ASSERT_EQ(t, read(n_blocks_at, 9));
+  ASSERT_THROW(read(n_blocks_at, 1), std::runtime_error);
+  ASSERT_THROW(read(n_blocks_at, 1000), std::runtime_error);
+  ASSERT_THROW(read(n_blocks_at + 8, 1), std::runtime_error);
+  ASSERT_THROW(read(n_blocks_at + 2 * 8, ~std::uint64_t{0}), std::runtime_error);
+  ASSERT_THROW(read(n_blocks_at - 8, t.size() + 1), std::runtime_error);
+
+  // A sorted but wrong payload offset is only detected while decoding the blocks
+  std::uint64_t offset;
+  std::memcpy(&offset, stream.data() + n_blocks_at + 2 * 8, sizeof(offset));
+  ASSERT_THROW(read(n_blocks_at + 2 * 8, offset - 3), std::runtime_error);
+  auto s = tamper(n_blocks_at + 2 * 8, offset - 3);
+  libtensor::CompressedReader<double, 3> reader(s);
+  ASSERT_THROW(reader.read_range(0, 2000), std::runtime_error);
+  ASSERT_EQ(reader.read_range(2000, 3000).size(), 1000u);
+}
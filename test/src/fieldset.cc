@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <libtensor/libtensor.hh>
+
+using Tensor2D = libtensor::Tensor<double, 2>;
+using Tensor3D = libtensor::Tensor<double, 3>;
+using Point = std::array<double, 2>;
+using SoA2D = libtensor::FieldSet<double, 2, 2, libtensor::Layout::SOA>;
+using AoS2D = libtensor::FieldSet<double, 2, 2, libtensor::Layout::AOS>;
+using SoA3D = libtensor::FieldSet<double, 2, 3, libtensor::Layout::SOA>;
+
+template <typename FS>
+void check_map() {
+  auto fs = FS::fromShape({2, 3});
+  const auto other = FS::like(fs).fill({1.0, 2.0});
+  const auto phi = Tensor2D::fromShape({2, 3}).fill(0.5);
+  const auto conc = Tensor2D::fromShape({2, 3}).fill(3.0);
+  auto actual = Tensor2D::like(phi);
+
+  ASSERT_THAT(fs.shape(), testing::ElementsAre(2, 3));
+  fs.load(0, phi).load(1, conc);
+
+  // Update both components of a point together
+  fs.map([](Point &p, const Point &o) { p = {p[0] + o[1] * p[1], p[0] * o[0]}; }, other);
+
+  fs.store(0, actual);
+  ASSERT_EQ(actual, Tensor2D::like(phi).fill(6.5));
+  fs.store(1, actual);
+  ASSERT_EQ(actual, Tensor2D::like(phi).fill(0.5));
+
+  ASSERT_THROW(fs.load(2, phi), std::invalid_argument);
+  ASSERT_THROW((fs.map_safe([](Point &, const Point &) {}, FS::fromShape({1, 1}))),
+               std::invalid_argument);
+}
+
+TEST(fieldset, map_soa) { check_map<SoA2D>(); }
+
+TEST(fieldset, map_aos) { check_map<AoS2D>(); }
+
+TEST(fieldset, field) {
+  auto fs = SoA3D::fromShape({2, 2, 2}).fill({1.0, 2.0});
+  fs.field(1).fill(4.0);
+  fs.map([](Point &p) { p[0] += p[1]; });
+
+  const auto expect1 = Tensor3D::like(fs.field(0)).fill(5.0);
+  const auto expect2 = Tensor3D::like(fs.field(1)).fill(4.0);
+
+  ASSERT_EQ(fs.field(0), expect1);
+  ASSERT_EQ(fs.field(1), expect2);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <libtensor/libtensor.hh>
+
+#include <cmath>
+#include <limits>
+
+namespace math = libtensor::math;
+namespace functor = libtensor::functor;
+using Tensor2D = libtensor::Tensor<double, 2>;
+
+/* Distance between a and b in units in the last place of b */
+template <typename T>
+double ulps(const T a, const T b) {
+  const T ulp = std::nextafter(std::abs(b), std::numeric_limits<T>::infinity()) - std::abs(b);
+  return std::abs(static_cast<double>(a) - static_cast<double>(b)) / static_cast<double>(ulp);
+}
+
+template <typename T, typename F, typename G>
+double max_ulps(F &&f, G &&g, const T lo, const T hi, const bool log_scale = false) {
+  constexpr int n = 100000;
+  double ret = 0.0;
+  for (int i = 0; i <= n; ++i) {
+    const double u = static_cast<double>(i) / n;
+    const double y = log_scale ? std::log(lo) + u * (std::log(hi) - std::log(lo)) : 0.0;
+    const T x = static_cast<T>(log_scale ? std::exp(y) : lo + u * (hi - lo));
+    ret = std::max(ret, ulps(f(x), g(x)));
+  }
+  return ret;
+}
+
+TEST(math, exp) {
+  const auto e = [](auto x) { return math::exp(x); };
+  const auto s = [](auto x) { return std::exp(x); };
+  ASSERT_LE(max_ulps(e, s, -745.0, 709.7), 2.0);
+  ASSERT_LE(max_ulps(e, s, -1.0, 1.0), 2.0);
+  ASSERT_LE(max_ulps(e, s, -87.0f, 88.7f), 2.0);
+
+  constexpr auto inf = std::numeric_limits<double>::infinity();
+  ASSERT_EQ(1.0, math::exp(0.0));
+  ASSERT_EQ(inf, math::exp(1000.0));
+  ASSERT_EQ(0.0, math::exp(-1000.0));
+  ASSERT_EQ(inf, math::exp(inf));
+  ASSERT_EQ(0.0, math::exp(-inf));
+  ASSERT_TRUE(std::isnan(math::exp(std::nan(""))));
+}
+
+TEST(math, log) {
+  const auto l = [](auto x) { return math::log(x); };
+  const auto s = [](auto x) { return std::log(x); };
+  ASSERT_LE(max_ulps(l, s, 1e-320, 1e300, true), 4.0);
+  ASSERT_LE(max_ulps(l, s, 0.5, 2.0), 4.0);
+  ASSERT_LE(max_ulps(l, s, 1e-44f, 1e38f, true), 4.0);
+
+  constexpr auto inf = std::numeric_limits<double>::infinity();
+  ASSERT_EQ(0.0, math::log(1.0));
+  ASSERT_EQ(-inf, math::log(0.0));
+  ASSERT_EQ(-inf, math::log(-0.0));
+  ASSERT_EQ(inf, math::log(inf));
+  ASSERT_TRUE(std::isnan(math::log(-1.0)));
+  ASSERT_TRUE(std::isnan(math::log(-inf)));
+  ASSERT_TRUE(std::isnan(math::log(std::nan(""))));
+}
+
+TEST(math, tanh) {
+  const auto t = [](auto x) { return math::tanh(x); };
+  const auto s = [](auto x) { return std::tanh(x); };
+  const auto em1 = [](auto x) { return math::expm1(x); };
+  const auto sem1 = [](auto x) { return std::expm1(x); };
+  ASSERT_LE(max_ulps(t, s, -25.0, 25.0), 5.0);
+  ASSERT_LE(max_ulps(t, s, 1e-12, 1.0, true), 5.0);
+  ASSERT_LE(max_ulps(t, s, -10.0f, 10.0f), 5.0);
+  ASSERT_LE(max_ulps(em1, sem1, -3.0, 3.0), 5.0);
+  ASSERT_LE(max_ulps(em1, sem1, 1e-12, 1.0, true), 5.0);
+
+  constexpr auto inf = std::numeric_limits<double>::infinity();
+  ASSERT_EQ(0.0, math::tanh(0.0));
+  ASSERT_EQ(1.0, math::tanh(inf));
+  ASSERT_EQ(-1.0, math::tanh(-inf));
+  ASSERT_TRUE(std::signbit(math::tanh(-0.0)));
+  ASSERT_TRUE(std::isnan(math::tanh(std::nan(""))));
+}
+
+TEST(math, polynomial) {
+  ASSERT_EQ(1.0, math::powi<0>(3.0));
+  ASSERT_EQ(243.0, math::powi<5>(3.0));
+  ASSERT_EQ(0.125, math::powi<-3>(2.0));
+  const std::array<double, 3> c{1.0, 2.0, 1.0};
+  ASSERT_EQ(9.0, math::horner(c, 2.0));
+  ASSERT_EQ(-1.0, math::clamp(-3.0, -1.0, 1.0));
+  ASSERT_EQ(0.5, math::clamp(0.5, -1.0, 1.0));
+  ASSERT_EQ(1.0, math::clamp(3.0, -1.0, 1.0));
+  ASSERT_TRUE(std::isnan(math::clamp(std::nan(""), -1.0, 1.0)));
+}
+
+TEST(math, functor) {
+  auto t = Tensor2D::fromShape({3, 5});
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 5; ++j) {
+      t[i][j] = 0.25 * i + 0.1 * j;
+    }
+  }
+  const auto check = [&](auto &&f, auto &&g) {
+    auto ret = Tensor2D::like(t);
+    ret.map(f, t);
+    auto in_place = t;
+    in_place.map(f);
+    for (std::size_t i = 0; i < 3; ++i) {
+      for (std::size_t j = 0; j < 5; ++j) {
+        ASSERT_NEAR(g(t[i][j]), ret[i][j], 1e-14);
+        ASSERT_EQ(ret[i][j], in_place[i][j]);
+      }
+    }
+  };
+  check(functor::ExpFunctor<double>(), [](double x) { return std::exp(x); });
+  check(functor::TanhFunctor<double>(), [](double x) { return std::tanh(x); });
+  check(functor::PowFunctor<double, 3>(), [](double x) { return x * x * x; });
+  check(functor::ClampFunctor<double>(0.2, 0.6),
+        [](double x) { return std::min(std::max(x, 0.2), 0.6); });
+  check(functor::PolyFunctor<double, 3>({1.0, -2.0, 3.0}),
+        [](double x) { return 1.0 - 2.0 * x + 3.0 * x * x; });
+  check(functor::DoubleWellFunctor<double>(), [](double x) { return x * x * x - x; });
+  check(functor::InterpFunctor<double>(),
+        [](double x) { return x * x * x * (6.0 * x * x - 15.0 * x + 10.0); });
+
+  auto log_t = t + 1.0;
+  auto ret = Tensor2D::like(t);
+  ret.map(functor::LogFunctor<double>(), log_t);
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 5; ++j) {
+      ASSERT_NEAR(std::log(log_t[i][j]), ret[i][j], 1e-14);
+    }
+  }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <libtensor/filter.hh>
+#include <libtensor/libtensor.hh>
+#include <libtensor/multigrid.hh>
+
+#include <numeric>
+#include <vector>
+
+using Tensor2D = libtensor::Tensor<double, 2>;
+using Tensor3D = libtensor::Tensor<double, 3>;
+using libtensor::BorderType;
+using libtensor::CycleType;
+using libtensor::SmootherType;
+
+template <BorderType BT>
+double at(const Tensor2D &u, int64_t i, int64_t j, double g) {
+  const auto &s = u.shape();
+  i = libtensor::border_index<BT>(i, s[0]);
+  j = libtensor::border_index<BT>(j, s[1]);
+  return (i < 0 || j < 0) ? g : u[i][j];
+}
+
+template <BorderType BT>
+double at(const Tensor3D &u, int64_t i, int64_t j, int64_t k, double g) {
+  const auto &s = u.shape();
+  i = libtensor::border_index<BT>(i, s[0]);
+  j = libtensor::border_index<BT>(j, s[1]);
+  k = libtensor::border_index<BT>(k, s[2]);
+  return (i < 0 || j < 0 || k < 0) ? g : u[i][j][k];
+}
+
+// f = alpha * u - beta * laplacian(u) with the 5-point Laplacian
+template <BorderType BT>
+Tensor2D apply(const Tensor2D &u, double h, double alpha, double beta, double g) {
+  auto f = Tensor2D::like(u);
+  const auto &s = u.shape();
+  for (int64_t i = 0; i < static_cast<int64_t>(s[0]); ++i) {
+    for (int64_t j = 0; j < static_cast<int64_t>(s[1]); ++j) {
+      const double lap = at<BT>(u, i - 1, j, g) + at<BT>(u, i + 1, j, g) +
+                         at<BT>(u, i, j - 1, g) + at<BT>(u, i, j + 1, g) - 4.0 * u[i][j];
+      f[i][j] = alpha * u[i][j] - beta * lap / (h * h);
+    }
+  }
+  return f;
+}
+
+template <BorderType BT>
+Tensor3D apply(const Tensor3D &u, double h, double alpha, double beta, double g) {
+  auto f = Tensor3D::like(u);
+  const auto &s = u.shape();
+  for (int64_t i = 0; i < static_cast<int64_t>(s[0]); ++i) {
+    for (int64_t j = 0; j < static_cast<int64_t>(s[1]); ++j) {
+      for (int64_t k = 0; k < static_cast<int64_t>(s[2]); ++k) {
+        const double lap = at<BT>(u, i - 1, j, k, g) + at<BT>(u, i + 1, j, k, g) +
+                           at<BT>(u, i, j - 1, k, g) + at<BT>(u, i, j + 1, k, g) +
+                           at<BT>(u, i, j, k - 1, g) + at<BT>(u, i, j, k + 1, g) -
+                           6.0 * u[i][j][k];
+        f[i][j][k] = alpha * u[i][j][k] - beta * lap / (h * h);
+      }
+    }
+  }
+  return f;
+}
+
+Tensor2D get_2d(std::size_t n) {
+  auto u = Tensor2D::fromShape({n, n});
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < n; ++j) {
+      u[i][j] = std::sin(0.2 * i) * std::cos(0.1 * j) + 0.001 * i * j;
+    }
+  }
+  return u;
+}
+
+Tensor3D get_3d(std::size_t n) {
+  auto u = Tensor3D::fromShape({n, n, n});
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < n; ++j) {
+      for (std::size_t k = 0; k < n; ++k) {
+        u[i][j][k] = std::sin(0.2 * i) * std::cos(0.1 * j) + 0.01 * k;
+      }
+    }
+  }
+  return u;
+}
+
+template <BorderType BT, typename Tensor>
+void check(const Tensor &expect, double h, double alpha, double beta, double g,
+           libtensor::Multigrid<double, Tensor::n_dims, BT> &mg, std::size_t max_iter) {
+  const auto f = apply<BT>(expect, h, alpha, beta, g);
+  auto u = Tensor::like(expect).fill(0.0);
+  const auto it = mg.solve(u, f);
+
+  ASSERT_LE(it, max_iter);
+  // Flag the points outside the tolerance; map runs in parallel, so nothing is accumulated
+  auto diff = u - expect;
+  diff.map([](double &v) { v = (std::abs(v) < 1e-7) ? 0.0 : 1.0; });
+  ASSERT_EQ(diff, Tensor::like(diff).fill(0.0));
+}
+
+// Pure Neumann problems determine the solution up to a constant, which is removed before comparing
+template <BorderType BT, typename Tensor>
+void check_neumann(const Tensor &expect, double h,
+                   libtensor::Multigrid<double, Tensor::n_dims, BT> &mg, std::size_t max_iter) {
+  const auto f = apply<BT>(expect, h, 0.0, -1.0, 0.0);
+  auto u = Tensor::like(expect).fill(0.0);
+  const auto it = mg.solve(u, f);
+
+  ASSERT_LE(it, max_iter);
+  auto diff = u - expect;
+  std::vector<double> flat(diff.size());
+  diff.copy_to(0, flat.size(), flat.data());
+  const double mean = std::accumulate(flat.begin(), flat.end(), 0.0) / flat.size();
+  diff.map([mean](double &v) { v = (std::abs(v - mean) < 1e-7) ? 0.0 : 1.0; });
+  ASSERT_EQ(diff, Tensor::like(diff).fill(0.0));
+}
+
+TEST(multigrid, poisson_dirichlet) {
+  const auto expect = get_2d(64);
+  const double h = 1.0 / 64;
+  libtensor::Multigrid<double, 2, BorderType::CONSTANT> mg(expect.shape(), h, 0.0, -1.0, 0.5);
+  ASSERT_EQ(mg.n_levels(), 6u);
+  check<BorderType::CONSTANT>(expect, h, 0.0, -1.0, 0.5, mg, 10);
+}
+
+TEST(multigrid, helmholtz_reflect) {
+  const auto expect = get_2d(64);
+  libtensor::Multigrid<double, 2, BorderType::REFLECT> mg(expect.shape(), 1.0, 1.0, 4.0);
+  check<BorderType::REFLECT>(expect, 1.0, 1.0, 4.0, 0.0, mg, 10);
+
+  mg.options().cycle = CycleType::W;
+  check<BorderType::REFLECT>(expect, 1.0, 1.0, 4.0, 0.0, mg, 10);
+
+  mg.options().cycle = CycleType::F;
+  mg.options().smoother = SmootherType::JACOBI;
+  check<BorderType::REFLECT>(expect, 1.0, 1.0, 4.0, 0.0, mg, 15);
+}
+
+TEST(multigrid, poisson_reflect) {
+  // The mirror plane of REFLECT is kept on coarse levels, so the cycle count does not grow with n
+  for (const std::size_t n : {32, 64, 128}) {
+    const auto expect = get_2d(n);
+    libtensor::Multigrid<double, 2, BorderType::REFLECT> mg(expect.shape(), 1.0 / n);
+    check_neumann<BorderType::REFLECT>(expect, 1.0 / n, mg, 12);
+  }
+  const auto expect = get_3d(32);
+  libtensor::Multigrid<double, 3, BorderType::REFLECT> mg(expect.shape(), 1.0 / 32);
+  check_neumann<BorderType::REFLECT>(expect, 1.0 / 32, mg, 12);
+}
+
+TEST(multigrid, helmholtz_3d) {
+  const auto expect = get_3d(16);
+  libtensor::Multigrid<double, 3, BorderType::WRAP> mg(expect.shape(), 1.0, 1.0, 2.0);
+  check<BorderType::WRAP>(expect, 1.0, 1.0, 2.0, 0.0, mg, 10);
+
+  // Odd extents on the outer axes: the periodic rows share a colour and are smoothed serially
+  const auto odd = get_3d(16);
+  auto expect_odd = Tensor3D::fromShape({15, 9, 16});
+  for (std::size_t i = 0; i < 15; ++i) {
+    for (std::size_t j = 0; j < 9; ++j) {
+      expect_odd[i][j] = odd[i][j];
+    }
+  }
+  libtensor::Multigrid<double, 3, BorderType::WRAP> mg_odd(expect_odd.shape(), 1.0, 1.0, 2.0);
+  check<BorderType::WRAP>(expect_odd, 1.0, 1.0, 2.0, 0.0, mg_odd, 30);
+
+  libtensor::Multigrid<double, 3, BorderType::REPLICATE> mg2(expect.shape(), 1.0, 1.0, 2.0);
+  check<BorderType::REPLICATE>(expect, 1.0, 1.0, 2.0, 0.0, mg2, 10);
+}
+
+TEST(multigrid, invalid) {
+  libtensor::Multigrid<double, 2> mg({8, 8});
+  auto u = Tensor2D::fromShape({8, 4});
+  const auto f = Tensor2D::fromShape({8, 8});
+  ASSERT_THROW(mg.solve(u, f), std::invalid_argument);
+}
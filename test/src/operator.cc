@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <libtensor/libtensor.hh>
 
@@ -115,3 +116,29 @@ TEST(operator, operator_div) {
   ASSERT_EQ(expect3, (t1 / t2));
   ASSERT_EQ(expect4, (t2 / t1));
 }
+
+TEST(operator, operator_out) {
+  const auto t1 = get_t1();
+  const auto t2 = get_t2();
+  auto out = Tensor2D::fromShape({4, 4});
+
+  ASSERT_EQ((t1 + t2), libtensor::add(out, t1, t2));
+  ASSERT_THAT(out.shape(), testing::ElementsAre(2, 2));
+  const auto *p = &out[0][0];
+  ASSERT_EQ((t1 + 1.0), libtensor::add(out, t1, 1.0));
+  ASSERT_EQ((1.0 - t1), libtensor::sub(out, 1.0, t1));
+  ASSERT_EQ((t1 - t2), libtensor::sub(out, t1, t2));
+  ASSERT_EQ((t1 * 2.0), libtensor::mul(out, t1, 2.0));
+  ASSERT_EQ((t1 * t2), libtensor::mul(out, t1, t2));
+  ASSERT_EQ((t1 / 2.0), libtensor::div(out, t1, 2.0));
+  ASSERT_EQ((2.0 / t2), libtensor::div(out, 2.0, t2));
+  ASSERT_EQ(-t1, libtensor::neg(out, t1));
+  ASSERT_EQ(p, &out[0][0]);
+
+  // The output may be an operand
+  auto acc = get_t1();
+  libtensor::add(acc, acc, t2);
+  ASSERT_EQ((t1 + t2), acc);
+
+  ASSERT_THROW(libtensor::add(out, t1, Tensor2D::fromShape({1, 2})), std::invalid_argument);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <libtensor/active.hh>
+#include <libtensor/filter.hh>
+#include <libtensor/libtensor.hh>
+#include <libtensor/stencil.hh>
+
+using Tensor2D = libtensor::Tensor<double, 2>;
+using libtensor::BorderType;
+
+Tensor2D get_tensor() {
+  auto t = Tensor2D::fromShape({37, 23});
+  for (std::size_t i = 0; i < 37; ++i) {
+    for (std::size_t j = 0; j < 23; ++j) {
+      t[i][j] = std::sin(0.3 * i) * std::cos(0.7 * j) + 0.01 * i * j;
+    }
+  }
+  return t;
+}
+
+Tensor2D get_2d_filter() {
+  auto f = Tensor2D::fromShape({3, 3});
+  f[0][0] = 0.0, f[0][1] = 1.0, f[0][2] = 0.0;
+  f[1][0] = 2.0, f[1][1] = -6.0, f[1][2] = 2.0;
+  f[2][0] = 0.0, f[2][1] = 1.0, f[2][2] = 0.0;
+  return f;
+}
+
+const auto euler = [](double &ret, const double &u, const double &lap) { ret = u + 0.05 * lap; };
+
+// Reference: one full conv2d and map per step
+template <BorderType BT>
+Tensor2D reference(const Tensor2D &t, const Tensor2D &filter, std::size_t steps, double cst) {
+  auto u = t;
+  auto lap = Tensor2D::like(t);
+  const libtensor::ActiveMask<2> all(t.shape(), 8);
+  for (std::size_t s = 0; s < steps; ++s) {
+    libtensor::conv2d_active<double, BT>(all, u, filter, lap, cst);
+    u.map([](double &v, const double &l) { euler(v, v, l); }, lap);
+  }
+  return u;
+}
+
+template <BorderType BT>
+void check(std::size_t steps, std::size_t tile, double cst = 0.0) {
+  const auto filter = get_2d_filter();
+  const auto t = get_tensor();
+  const auto expect = reference<BT>(t, filter, steps, cst);
+
+  auto actual = Tensor2D::like(t);
+  libtensor::stencil2d<double, BT>(t, filter, actual, euler, steps, tile, cst);
+  for (std::size_t i = 0; i < 37; ++i) {
+    for (std::size_t j = 0; j < 23; ++j) {
+      ASSERT_DOUBLE_EQ(expect[i][j], actual[i][j]) << "at " << i << ", " << j;
+    }
+  }
+
+  // In-place update
+  auto inplace = t;
+  libtensor::stencil2d<double, BT>(inplace, filter, inplace, euler, steps, tile, cst);
+  ASSERT_EQ(actual, inplace);
+}
+
+TEST(stencil, reflect) {
+  for (std::size_t steps = 0; steps < 5; ++steps) {
+    check<BorderType::REFLECT>(steps, 8);
+  }
+  check<BorderType::REFLECT>(3, 1);
+  check<BorderType::REFLECT>(4, 64);
+}
+
+TEST(stencil, replicate) { check<BorderType::REPLICATE>(4, 5); }
+
+TEST(stencil, constant) { check<BorderType::CONSTANT>(4, 6, 0.5); }
+
+TEST(stencil, conv2d) {
+  const auto filter = get_2d_filter();
+  const auto t = get_tensor();
+  auto expect = Tensor2D::like(t);
+  auto actual = Tensor2D::like(t);
+
+  libtensor::conv2d<double>(t, filter, expect);
+  libtensor::stencil2d<double>(
+      t, filter, actual, [](double &ret, const double &, const double &c) { ret = c; }, 1, 16);
+  ASSERT_EQ(expect, actual);
+
+  ASSERT_THROW((libtensor::stencil2d<double, BorderType::WRAP>(t, filter, actual, euler, 1)),
+               std::invalid_argument);
+  ASSERT_THROW((libtensor::stencil2d<double>(t, filter, actual, euler, 1, 0)),
+               std::invalid_argument);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <libtensor/writer.hh>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Tensor2D = libtensor::Tensor<double, 2>;
+using Tensor3D = libtensor::Tensor<float, 3>;
+
+std::vector<std::uint8_t> decode64(const std::string &s) {
+  const std::string chars = libtensor::output::base64_chars;
+  std::vector<std::uint8_t> ret;
+  std::uint32_t v = 0;
+  int bits = 0;
+  for (const char c : s) {
+    if (c == '=') {
+      break;
+    }
+    v = (v << 6) | static_cast<std::uint32_t>(chars.find(c));
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      ret.push_back(static_cast<std::uint8_t>(v >> bits));
+    }
+  }
+  return ret;
+}
+
+std::string between(const std::string &s, const std::string &begin, const std::string &end) {
+  const auto b = s.find(begin) + begin.size();
+  return s.substr(b, s.find(end, b) - b);
+}
+
+Tensor2D get_field(const std::size_t ny, const std::size_t nx) {
+  auto t = Tensor2D::fromShape({ny, nx});
+  for (std::size_t i = 0; i < ny; ++i) {
+    for (std::size_t j = 0; j < nx; ++j) {
+      t[i][j] = 100.0 * i + j;
+    }
+  }
+  return t;
+}
+
+TEST(writer, base64) {
+  const std::string text = "libtensor";
+  for (std::size_t n = 0; n <= text.size(); ++n) {
+    std::string out((n + 2) / 3 * 4, ' ');
+    libtensor::output::base64(reinterpret_cast<const std::uint8_t *>(text.data()), n, out.data());
+    const auto back = decode64(out);
+    ASSERT_EQ(text.substr(0, n), std::string(back.begin(), back.end()));
+  }
+  std::string out(8, ' ');
+  libtensor::output::base64(reinterpret_cast<const std::uint8_t *>("Man"), 3, out.data());
+  libtensor::output::base64(reinterpret_cast<const std::uint8_t *>("Ma"), 2, out.data() + 4);
+  ASSERT_EQ("TWFuTWE=", out);
+}
+
+TEST(writer, vtk) {
+  const auto t = get_field(5, 7);
+  std::ostringstream os;
+  {
+    // A small chunk forces several chunks whose sizes are not multiples of 3 bytes
+    libtensor::VTKWriter<2> w(os, t.shape(), 2, 0.5, 40);
+    w.write("phi", t);
+  }
+  const auto s = os.str();
+  ASSERT_NE(s.find("WholeExtent=\"0 3 0 2 0 0\""), std::string::npos);
+  ASSERT_NE(s.find("Spacing=\"1 1 0.5\""), std::string::npos);
+  ASSERT_NE(s.find("</VTKFile>"), std::string::npos);
+
+  // Separately encoded UInt64 byte count, then the data
+  const auto body = between(s, "format=\"binary\">\n", "\n</DataArray>");
+  const auto header = decode64(body.substr(0, 12));
+  std::uint64_t bytes;
+  std::memcpy(&bytes, header.data(), sizeof(bytes));
+  ASSERT_EQ(3u * 4u * sizeof(double), bytes);
+  const auto data = decode64(body.substr(12));
+  ASSERT_EQ(bytes, data.size());
+  std::vector<double> values(3 * 4);
+  std::memcpy(values.data(), data.data(), bytes);
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      ASSERT_EQ(t[2 * i][2 * j], values[i * 4 + j]);
+    }
+  }
+
+  ASSERT_THROW(libtensor::VTKWriter<2>(os, t.shape(), 0), std::invalid_argument);
+  libtensor::VTKWriter<2> w(os, t.shape());
+  ASSERT_THROW(w.write("phi", get_field(4, 7)), std::invalid_argument);
+  ASSERT_THROW(w.write("a b", t), std::invalid_argument);
+
+  // Empty grids along either axis still give an array with a zero byte count
+  for (const auto shape : {Tensor2D::Shape{3, 0}, Tensor2D::Shape{0, 3}}) {
+    std::ostringstream empty;
+    libtensor::VTKWriter<2>(empty, shape).write("phi", Tensor2D::fromShape(shape));
+    const auto e = between(empty.str(), "format=\"binary\">\n", "\n</DataArray>");
+    ASSERT_EQ(12u, e.size());
+    std::memcpy(&bytes, decode64(e).data(), sizeof(bytes));
+    ASSERT_EQ(0u, bytes);
+  }
+}
+
+TEST(writer, xdmf) {
+  auto t = Tensor3D::fromShape({3, 4, 5});
+  auto fs = libtensor::FieldSet<float, 3, 3, libtensor::Layout::AOS>::fromShape(t.shape());
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      for (std::size_t k = 0; k < 5; ++k) {
+        t[i][j][k] = static_cast<float>(100 * i + 10 * j + k);
+      }
+    }
+  }
+  fs.load(0, t).load(1, t + 1.0f).load(2, t + 2.0f);
+
+  std::ostringstream xml, bin;
+  {
+    libtensor::XDMFWriter<3> w(xml, bin, "out.bin", t.shape());
+    w.write("c", t).write("v", fs);
+  }
+  const auto s = xml.str();
+  ASSERT_NE(s.find("TopologyType=\"3DCoRectMesh\" Dimensions=\"3 4 5\""), std::string::npos);
+  ASSERT_NE(s.find("AttributeType=\"Vector\""), std::string::npos);
+  ASSERT_NE(s.find("Seek=\"240\" Dimensions=\"3 4 5 3\">out.bin"), std::string::npos);
+
+  const auto raw = bin.str();
+  ASSERT_EQ(4u * 60u * sizeof(float), raw.size());
+  std::vector<float> values(4 * 60);
+  std::memcpy(values.data(), raw.data(), raw.size());
+  ASSERT_EQ(t[2][3][4], values[59]);
+  ASSERT_EQ(t[1][2][3] + 2.0f, values[60 + (20 + 10 + 3) * 3 + 2]);
+
+  std::ostringstream empty_xml, empty_bin;
+  {
+    const Tensor3D::Shape shape{3, 4, 0};
+    libtensor::XDMFWriter<3> w(empty_xml, empty_bin, "out.bin", shape);
+    w.write("c", Tensor3D::fromShape(shape)).write("v", decltype(fs)::fromShape(shape));
+  }
+  ASSERT_NE(empty_xml.str().find("Seek=\"0\" Dimensions=\"3 4 0 3\">out.bin"),
+            std::string::npos);
+  ASSERT_TRUE(empty_bin.str().empty());
+}